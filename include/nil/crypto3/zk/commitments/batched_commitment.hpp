@@ -25,6 +25,8 @@
 #ifndef CRYPTO3_ZK_STUB_PLACEHOLDER_COMMITMENT_SCHEME_HPP
 #define CRYPTO3_ZK_STUB_PLACEHOLDER_COMMITMENT_SCHEME_HPP
 
+#include <algorithm>
+#include <array>
 #include <set>
 #include <map>
 
@@ -33,8 +35,10 @@
 
 #include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
 
+#include <nil/crypto3/zk/detail/parallelization.hpp>
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 #include <nil/crypto3/zk/commitments/type_traits.hpp>
+#include <nil/crypto3/zk/commitments/detail/polynomial/barycentric_evaluation.hpp>
 #include <nil/crypto3/zk/commitments/detail/polynomial/eval_storage.hpp>
 
 namespace nil {
@@ -90,14 +94,21 @@ namespace nil {
                     }
 
                     math::polynomial<typename field_type::value_type> get_U(std::size_t b_ind, std::size_t poly_ind) const {
+                        return get_U(this->_z, b_ind, poly_ind);
+                    }
+
+                    // U of the values in z, the verifier reads them from the proof without a copy.
+                    math::polynomial<typename field_type::value_type> get_U(const eval_storage<field_type> &z,
+                                                                            std::size_t b_ind,
+                                                                            std::size_t poly_ind) const {
 
                         const auto &points = _points.at(b_ind)[poly_ind];
-                        BOOST_ASSERT(points.size() == this->_z.get_poly_points_number(b_ind, poly_ind));
+                        BOOST_ASSERT(points.size() == z.get_poly_points_number(b_ind, poly_ind));
                         std::vector<std::pair<typename field_type::value_type,typename field_type::value_type>> U_interpolation_points;
 
                         U_interpolation_points.resize(points.size());
                         for(std::size_t k = 0; k < points.size(); k++){
-                            U_interpolation_points[k] = std::make_pair( points[k], this->_z.get(b_ind, poly_ind, k) );
+                            U_interpolation_points[k] = std::make_pair( points[k], z.get(b_ind, poly_ind, k) );
                         }
 
                         return math::lagrange_interpolation(U_interpolation_points);
@@ -149,17 +160,84 @@ namespace nil {
                     }
 
                     void eval_polys() {
+                        if constexpr (std::is_same<math::polynomial_dfs<typename field_type::value_type>,
+                                                   PolynomialType>::value) {
+                            eval_polys_dfs();
+                            return;
+                        }
                         for(auto const &[k, poly] : _polys) {
                             _z.set_batch_size(k, poly.size());
                             auto const &point = _points.at(k);
 
                             BOOST_ASSERT(poly.size() == point.size() || point.size() == 1);
 
+                            // Evaluations run in parallel, the storage is filled afterwards.
+                            std::vector<std::vector<typename field_type::value_type>> values(poly.size());
+                            zk::detail::parallel_for(0, poly.size(), [&poly, &point, &values](std::size_t i) {
+                                values[i].resize(point[i].size());
+                                for (std::size_t j = 0; j < point[i].size(); j++) {
+                                    values[i][j] = poly[i].evaluate(point[i][j]);
+                                }
+                            });
+
                             for (std::size_t i = 0; i < poly.size(); i++) {
                                 _z.set_poly_points_number(k, i, point[i].size());
 
                                 for (std::size_t j = 0; j < point[i].size(); j++) {
-                                    _z.set(k, i, j, poly[i].evaluate(point[i][j]));
+                                    _z.set(k, i, j, values[i][j]);
+                                }
+                            }
+                        }
+                    }
+
+                    // Polynomials are grouped by the opening point and their size, the barycentric weights
+                    // of a group are computed once for all its polynomials.
+                    void eval_polys_dfs() {
+                        using value_type = typename field_type::value_type;
+
+                        // (size, point) of the groups and the (batch, polynomial, point index) in every group
+                        std::vector<std::pair<std::size_t, value_type>> groups;
+                        std::vector<std::vector<std::array<std::size_t, 3>>> evaluations;
+                        std::map<std::size_t, std::vector<std::vector<value_type>>> values;
+                        for(auto const &[k, poly] : _polys) {
+                            auto const &point = _points.at(k);
+                            BOOST_ASSERT(poly.size() == point.size() || point.size() == 1);
+
+                            values[k].resize(poly.size());
+                            for (std::size_t i = 0; i < poly.size(); i++) {
+                                values[k][i].resize(point[i].size());
+                                for (std::size_t j = 0; j < point[i].size(); j++) {
+                                    std::pair<std::size_t, value_type> group(poly[i].size(), point[i][j]);
+                                    std::size_t group_index = std::find(groups.begin(), groups.end(), group) - groups.begin();
+                                    if (group_index == groups.size()) {
+                                        groups.push_back(group);
+                                        evaluations.emplace_back();
+                                    }
+                                    evaluations[group_index].push_back({k, i, j});
+                                }
+                            }
+                        }
+
+                        for (std::size_t group_index = 0; group_index < groups.size(); group_index++) {
+                            std::vector<const poly_type *> group_polys;
+                            group_polys.reserve(evaluations[group_index].size());
+                            for (const auto &[k, i, j] : evaluations[group_index]) {
+                                group_polys.push_back(&_polys.at(k)[i]);
+                            }
+                            std::vector<value_type> group_values = detail::barycentric_evaluate<field_type>(
+                                group_polys, groups[group_index].second);
+                            for (std::size_t e = 0; e < group_values.size(); e++) {
+                                const auto &[k, i, j] = evaluations[group_index][e];
+                                values[k][i][j] = group_values[e];
+                            }
+                        }
+
+                        for(auto const &[k, poly] : _polys) {
+                            _z.set_batch_size(k, poly.size());
+                            for (std::size_t i = 0; i < poly.size(); i++) {
+                                _z.set_poly_points_number(k, i, values[k][i].size());
+                                for (std::size_t j = 0; j < values[k][i].size(); j++) {
+                                    _z.set(k, i, j, values[k][i][j]);
                                 }
                             }
                         }
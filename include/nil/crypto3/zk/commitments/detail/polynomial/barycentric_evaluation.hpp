@@ -0,0 +1,142 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_COMMITMENTS_DETAIL_BARYCENTRIC_EVALUATION_HPP
+#define CRYPTO3_ZK_COMMITMENTS_DETAIL_BARYCENTRIC_EVALUATION_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <nil/crypto3/math/algorithms/unity_root.hpp>
+#include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
+
+#include <nil/crypto3/zk/detail/batch_inversion.hpp>
+#include <nil/crypto3/zk/detail/parallelization.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace commitments {
+                namespace detail {
+
+                    /**
+                     * @brief Values at x of polynomial_dfs given on the same domain of size n, by the barycentric formula
+                     * p(x) = (x^n - 1) / n * sum_i p(omega^i) * omega^i / (x - omega^i).
+                     * The weights omega^i / (x - omega^i) depend on x and n only. They are computed once with
+                     * a batch inversion and shared by all the polynomials, each of which costs n multiplications.
+                     * A point of the domain is read from the values.
+                     */
+                    template<typename FieldType>
+                    std::vector<typename FieldType::value_type>
+                        barycentric_evaluate(const std::vector<const math::polynomial_dfs<typename FieldType::value_type> *> &polys,
+                                             const typename FieldType::value_type &x) {
+                        using value_type = typename FieldType::value_type;
+
+                        std::vector<value_type> result(polys.size());
+                        if (polys.empty()) {
+                            return result;
+                        }
+                        const std::size_t n = polys.front()->size();
+                        BOOST_ASSERT(n > 0 && (n & (n - 1)) == 0);
+                        for (const auto *poly : polys) {
+                            BOOST_ASSERT(poly->size() == n);
+                        }
+
+                        const value_type omega = math::unity_root<FieldType>(n);
+                        std::vector<value_type> weights(n);
+                        std::vector<value_type> denominators(n);
+                        std::atomic<std::size_t> domain_index(n);
+                        zk::detail::parallel_for_chunks(0, n, [&](std::size_t begin, std::size_t end) {
+                            value_type omega_i = omega.pow(begin);
+                            for (std::size_t i = begin; i < end; i++) {
+                                weights[i] = omega_i;
+                                denominators[i] = x - omega_i;
+                                if (denominators[i] == value_type::zero()) {
+                                    domain_index = i;
+                                }
+                                omega_i *= omega;
+                            }
+                        }, 4096);
+
+                        if (domain_index.load() < n) {
+                            for (std::size_t k = 0; k < polys.size(); k++) {
+                                result[k] = (*polys[k])[domain_index.load()];
+                            }
+                            return result;
+                        }
+
+                        zk::detail::batch_inversion(denominators);
+                        const value_type scale = (x.pow(n) - value_type::one()) * value_type(n).inversed();
+                        zk::detail::parallel_for(0, n, [&weights, &denominators, &scale](std::size_t i) {
+                            weights[i] *= denominators[i] * scale;
+                        }, 4096);
+                        std::vector<value_type>().swap(denominators);
+
+                        // Few polynomials are split by chunks of the domain, many are evaluated one per task.
+                        const std::size_t threads = zk::detail::thread_pool::instance().size();
+                        if (polys.size() >= threads) {
+                            zk::detail::parallel_for(0, polys.size(), [&](std::size_t k) {
+                                const auto &poly = *polys[k];
+                                value_type sum = value_type::zero();
+                                for (std::size_t i = 0; i < n; i++) {
+                                    sum += poly[i] * weights[i];
+                                }
+                                result[k] = sum;
+                            });
+                        } else {
+                            const std::size_t chunk_size = std::max<std::size_t>((n + threads - 1) / threads, 1);
+                            const std::size_t chunks_num = (n + chunk_size - 1) / chunk_size;
+                            std::vector<std::vector<value_type>> partial(chunks_num,
+                                                                         std::vector<value_type>(polys.size()));
+                            zk::detail::parallel_for(0, chunks_num, [&](std::size_t chunk) {
+                                std::size_t begin = chunk * chunk_size;
+                                std::size_t end = std::min(n, begin + chunk_size);
+                                for (std::size_t k = 0; k < polys.size(); k++) {
+                                    const auto &poly = *polys[k];
+                                    value_type sum = value_type::zero();
+                                    for (std::size_t i = begin; i < end; i++) {
+                                        sum += poly[i] * weights[i];
+                                    }
+                                    partial[chunk][k] = sum;
+                                }
+                            });
+                            for (std::size_t k = 0; k < polys.size(); k++) {
+                                result[k] = value_type::zero();
+                                for (std::size_t chunk = 0; chunk < chunks_num; chunk++) {
+                                    result[k] += partial[chunk][k];
+                                }
+                            }
+                        }
+                        return result;
+                    }
+                }    // namespace detail
+            }        // namespace commitments
+        }            // namespace zk
+    }                // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_COMMITMENTS_DETAIL_BARYCENTRIC_EVALUATION_HPP
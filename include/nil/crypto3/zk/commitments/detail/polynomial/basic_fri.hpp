@@ -41,10 +41,16 @@
 #include <nil/crypto3/container/merkle/tree.hpp>
 #include <nil/crypto3/container/merkle/proof.hpp>
 
+#include <nil/crypto3/hash/algorithm/hash.hpp>
+
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 
+#include <nil/crypto3/zk/detail/batch_inversion.hpp>
+#include <nil/crypto3/zk/detail/parallelization.hpp>
 #include <nil/crypto3/zk/commitments/type_traits.hpp>
 #include <nil/crypto3/zk/commitments/detail/polynomial/fold_polynomial.hpp>
+#include <nil/crypto3/zk/commitments/detail/polynomial/merkle_multiproof.hpp>
+#include <nil/crypto3/zk/commitments/detail/polynomial/merkle_tree_builder.hpp>
 #include <nil/crypto3/zk/commitments/detail/polynomial/proof_of_work.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_scoped_profiler.hpp>
 
@@ -98,6 +104,8 @@ namespace nil {
                         using merkle_tree_type = containers::merkle_tree<MerkleTreeHashType, 2>;
                         using merkle_proof_type =  typename containers::merkle_proof<MerkleTreeHashType, 2>;
                         using precommitment_type = merkle_tree_type;
+                        // Prover-side tree that keeps only the upper levels, see params_type::merkle_subtree_height.
+                        using capped_precommitment_type = merkle_tree_cap<MerkleTreeHashType>;
                         using commitment_type = typename precommitment_type::value_type;
                         using transcript_type = transcript::fiat_shamir_heuristic_sequential<TranscriptHashType>;
                         using polynomial_type = math::polynomial<typename FieldType::value_type>;
@@ -126,6 +134,7 @@ namespace nil {
                                 max_degree = obj.max_degree;
                                 D = obj.D;
                                 step_list = obj.step_list;
+                                merkle_subtree_height = obj.merkle_subtree_height;
                             }
 
                             params_type() {};
@@ -134,6 +143,9 @@ namespace nil {
                             std::size_t max_degree;
                             std::vector<std::shared_ptr<math::evaluation_domain<FieldType>>> D;
                             std::vector<std::size_t> step_list;
+                            // Prover memory setting, proofs do not depend on it. Capped prover trees drop the
+                            // lowest merkle_subtree_height levels and rebuild them for every query path.
+                            std::size_t merkle_subtree_height = 0;
                         };
 
                         struct round_proof_type {
@@ -194,6 +206,48 @@ namespace nil {
                             std::array<query_proof_type, lambda>                query_proofs;     // 0...lambda - 1
                             typename GrindingType::output_type                  proof_of_work;
                         };
+
+                        using merkle_multiproof_type = merkle_multiproof<MerkleTreeHashType>;
+
+                        // Values of one query, the Merkle paths are kept in compressed_proof_type.
+                        struct compressed_query_proof_type {
+                            bool operator==(const compressed_query_proof_type &rhs) const {
+                                return initial_values == rhs.initial_values && round_values == rhs.round_values;
+                            }
+
+                            bool operator!=(const compressed_query_proof_type &rhs) const {
+                                return !(rhs == *this);
+                            }
+
+                            std::map<std::size_t, polynomials_values_type> initial_values;
+                            std::vector<polynomial_values_type> round_values;
+                        };
+
+                        /**
+                         * The same proof with the Merkle paths of all queries merged into one multi-proof per tree:
+                         * per initial batch and per round. Sibling nodes shared by several queries are stored
+                         * and hashed by the verifier once.
+                         */
+                        struct compressed_proof_type {
+                            bool operator==(const compressed_proof_type &rhs) const {
+                                return fri_roots == rhs.fri_roots &&
+                                       query_proofs == rhs.query_proofs &&
+                                       initial_multiproofs == rhs.initial_multiproofs &&
+                                       round_multiproofs == rhs.round_multiproofs &&
+                                       final_polynomial == rhs.final_polynomial;
+                            }
+
+                            bool operator!=(const compressed_proof_type &rhs) const {
+                                return !(rhs == *this);
+                            }
+
+                            std::vector<commitment_type>                        fri_roots;
+                            math::polynomial<typename field_type::value_type>   final_polynomial;
+                            std::array<compressed_query_proof_type, lambda>     query_proofs;
+                            std::map<std::size_t, merkle_multiproof_type>       initial_multiproofs;
+                            std::vector<merkle_multiproof_type>                 round_multiproofs;
+                            typename GrindingType::output_type                  proof_of_work;
+                        };
                     };
                     template <typename FRI>
                     constexpr bool use_grinding()
@@ -245,6 +299,79 @@ namespace nil {
                     return (x_index + domain_size / FRI::m) % domain_size;
                 }
 
+                /**
+                 * Domain indices of the values stored in the leaf x_index, in the order they are serialized:
+                 * pairs (s, paired(s)) of the coset that is folded into one point after fri_step rounds.
+                 */
+                template<typename FRI>
+                static std::vector<std::size_t> get_leaf_indices(std::size_t x_index, std::size_t domain_size,
+                                                                 std::size_t coset_size) {
+                    std::vector<std::array<std::size_t, FRI::m>> s_indices(coset_size / FRI::m);
+                    s_indices[0][0] = x_index;
+                    s_indices[0][1] = get_paired_index<FRI>(x_index, domain_size);
+
+                    std::size_t base_index = domain_size / (FRI::m * FRI::m);
+                    std::size_t prev_half_size = 1;
+                    std::size_t i = 1;
+                    while (i < coset_size / FRI::m) {
+                        for (std::size_t j = 0; j < prev_half_size; j++) {
+                            s_indices[i][0] = (base_index + s_indices[j][0]) % domain_size;
+                            s_indices[i][1] = get_paired_index<FRI>(s_indices[i][0], domain_size);
+                            i++;
+                        }
+                        base_index /= FRI::m;
+                        prev_half_size <<= 1;
+                    }
+
+                    std::vector<std::size_t> indices;
+                    indices.reserve(coset_size);
+                    for (const auto &pair : s_indices) {
+                        indices.insert(indices.end(), pair.begin(), pair.end());
+                    }
+                    return indices;
+                }
+
+                /**
+                 * Leaf bytes of one value, the same as FRI::field_element_type::write gives: length big-endian
+                 * bytes read straight from the limbs of its integral value, without a marshalling field.
+                 */
+                template<typename FRI, typename OutputIterator>
+                static inline void write_field_element(const typename FRI::field_type::value_type &value,
+                                                       std::size_t length, OutputIterator &write_iter) {
+                    using integral_type = typename FRI::field_type::integral_type;
+
+                    integral_type integral = integral_type(value.data);
+                    const auto *limbs = integral.backend().limbs();
+                    const std::size_t limbs_num = integral.backend().size();
+                    constexpr std::size_t limb_bytes = sizeof(*limbs);
+                    for (std::size_t byte = length; byte-- > 0;) {
+                        std::size_t limb = byte / limb_bytes;
+                        *write_iter = (limb < limbs_num) ? std::uint8_t(limbs[limb] >> (8 * (byte % limb_bytes))) :
+                                                           std::uint8_t(0);
+                        ++write_iter;
+                    }
+                }
+
+                // Leaf bytes of the values [first, last), see write_field_element.
+                template<typename FRI, typename ValueIterator, typename OutputIterator>
+                static inline void write_field_elements(ValueIterator first, ValueIterator last,
+                                                        OutputIterator &write_iter) {
+                    const std::size_t length = FRI::field_element_type::length();
+                    for (ValueIterator it = first; it != last; ++it) {
+                        write_field_element<FRI>(*it, length, write_iter);
+                    }
+                }
+
+                // Leaf bytes of values[index] for the indices of a coset, see write_field_element.
+                template<typename FRI, typename ValuesType, typename OutputIterator>
+                static inline void write_field_elements(const ValuesType &values, const std::vector<std::size_t> &indices,
+                                                        OutputIterator &write_iter) {
+                    const std::size_t length = FRI::field_element_type::length();
+                    for (std::size_t index : indices) {
+                        write_field_element<FRI>(values[index], length, write_iter);
+                    }
+                }
+
                 template<typename FRI,
                     typename std::enable_if<
                         std::is_base_of<
@@ -268,42 +395,16 @@ namespace nil {
                     std::size_t domain_size = D->size();
                     std::size_t coset_size = 1 << fri_step;
                     std::size_t leafs_number = domain_size / coset_size;
-                    std::size_t leaf_bytes = coset_size * FRI::field_element_type::length();
-                    std::vector<std::vector<std::uint8_t>> y_data(leafs_number, std::vector<std::uint8_t>(leaf_bytes));
-
-                    for (std::size_t x_index = 0; x_index < leafs_number; x_index++) {
-                        std::vector<std::array<std::size_t, FRI::m>> s_indices(coset_size / FRI::m);
-                        s_indices[0][0] = x_index;
-                        s_indices[0][1] = get_paired_index<FRI>(x_index, domain_size);
-
-                        auto write_iter = y_data[x_index].begin();
-                        typename FRI::field_element_type y_val0(f[s_indices[0][0]]);
-                        y_val0.write(write_iter, FRI::field_element_type::length());
-                        typename FRI::field_element_type y_val1(f[s_indices[0][1]]);
-                        y_val1.write(write_iter, FRI::field_element_type::length());
-
-                        std::size_t base_index = domain_size / (FRI::m * FRI::m);
-                        std::size_t prev_half_size = 1;
-                        std::size_t i = 1;
-                        while (i < coset_size / FRI::m) {
-                            for (std::size_t j = 0; j < prev_half_size; j++) {
-                                s_indices[i][0] = (base_index + s_indices[j][0]) % domain_size;
-                                s_indices[i][1] = get_paired_index<FRI>(s_indices[i][0], domain_size);
-
-                                typename FRI::field_element_type y_val0(f[s_indices[i][0]]);
-                                y_val0.write(write_iter, FRI::field_element_type::length());
-                                typename FRI::field_element_type y_val1(f[s_indices[i][1]]);
-                                y_val1.write(write_iter, FRI::field_element_type::length());
-
-                                i++;
-                            }
-                            base_index /= FRI::m;
-                            prev_half_size <<= 1;
-                        }
-                    }
+                    commitments::detail::flat_leaves_buffer leaves(
+                        leafs_number, coset_size * FRI::field_element_type::length());
+
+                    zk::detail::parallel_for(0, leafs_number, [&](std::size_t x_index) {
+                        auto write_iter = leaves.leaf_begin(x_index);
+                        write_field_elements<FRI>(f, get_leaf_indices<FRI>(x_index, domain_size, coset_size), write_iter);
+                    }, 64);
 
-                    return containers::make_merkle_tree<typename FRI::merkle_tree_hash_type, FRI::m>(y_data.begin(),
-                                                                                                     y_data.end());
+                    return commitments::detail::make_merkle_tree_parallel<typename FRI::merkle_tree_hash_type, FRI::m>(
+                        leaves);
                 }
 
                 template<typename FRI,
@@ -348,54 +449,31 @@ namespace nil {
                 ) {
                     PROFILE_PLACEHOLDER_SCOPE("Basic FRI Precommit time");
 
-                    for (int i = 0; i < poly.size(); ++i) {
+                    // Every column is extended with its own FFT.
+                    zk::detail::parallel_for(0, poly.size(), [&poly, &D](std::size_t i) {
                         if (poly[i].size() != D->size()) {
                             poly[i].resize(D->size());
                         }
-                    }
+                    });
 
                     std::size_t domain_size = D->size();
                     std::size_t list_size = poly.size();
                     std::size_t coset_size = 1 << fri_step;
                     std::size_t leafs_number = domain_size / coset_size;
-                    std::vector<std::vector<std::uint8_t>> y_data(
-                            leafs_number,
-                            std::vector<std::uint8_t>(coset_size * FRI::field_element_type::length() * list_size));
+                    commitments::detail::flat_leaves_buffer leaves(
+                        leafs_number, coset_size * FRI::field_element_type::length() * list_size);
 
-                    for (std::size_t x_index = 0; x_index < leafs_number; x_index++) {
-                        auto write_iter = y_data[x_index].begin();
+                    zk::detail::parallel_for(0, leafs_number, [&](std::size_t x_index) {
+                        // The coset layout is the same for every polynomial of the batch.
+                        std::vector<std::size_t> indices = get_leaf_indices<FRI>(x_index, domain_size, coset_size);
+                        auto write_iter = leaves.leaf_begin(x_index);
                         for (std::size_t polynom_index = 0; polynom_index < list_size; polynom_index++) {
-                            std::vector<std::array<std::size_t, FRI::m>> s_indices(coset_size / FRI::m);
-                            s_indices[0][0] = x_index;
-                            s_indices[0][1] = get_paired_index<FRI>(x_index, domain_size);
-
-                            typename FRI::field_element_type y_val0(poly[polynom_index][s_indices[0][0]]);
-                            y_val0.write(write_iter, FRI::field_element_type::length());
-                            typename FRI::field_element_type y_val1(poly[polynom_index][s_indices[0][1]]);
-                            y_val1.write(write_iter, FRI::field_element_type::length());
-
-                            std::size_t base_index = domain_size / (FRI::m * FRI::m);
-                            std::size_t prev_half_size = 1;
-                            std::size_t i = 1;
-                            while (i < coset_size / FRI::m) {
-                                for (std::size_t j = 0; j < prev_half_size; j++) {
-                                    s_indices[i][0] = (base_index + s_indices[j][0]) % domain_size;
-                                    s_indices[i][1] = get_paired_index<FRI>(s_indices[i][0], domain_size);
-                                    typename FRI::field_element_type y_val0(poly[polynom_index][s_indices[i][0]]);
-                                    y_val0.write(write_iter, FRI::field_element_type::length());
-                                    typename FRI::field_element_type y_val1(poly[polynom_index][s_indices[i][1]]);
-                                    y_val1.write(write_iter, FRI::field_element_type::length());
-
-                                    i++;
-                                }
-                                base_index /= FRI::m;
-                                prev_half_size <<= 1;
-                            }
+                            write_field_elements<FRI>(poly[polynom_index], indices, write_iter);
                         }
-                    }
+                    }, 16);
 
-                    return containers::make_merkle_tree<typename FRI::merkle_tree_hash_type, FRI::m>(y_data.begin(),
-                                                                                                     y_data.end());
+                    return commitments::detail::make_merkle_tree_parallel<typename FRI::merkle_tree_hash_type, FRI::m>(
+                        leaves);
                 }
 
                 template<typename FRI, typename ContainerType,
@@ -419,14 +497,99 @@ namespace nil {
                 ) {
                     std::size_t list_size = poly.size();
                     std::vector<math::polynomial_dfs<typename FRI::field_type::value_type>> poly_dfs(list_size);
-                    for (std::size_t i = 0; i < list_size; i++) {
+                    zk::detail::parallel_for(0, list_size, [&poly, &poly_dfs, &D](std::size_t i) {
                         poly_dfs[i].from_coefficients(poly[i]);
                         poly_dfs[i].resize(D->size());
-                    }
+                    });
 
                     return precommit<FRI>(poly_dfs, D, fri_step);
                 }
 
+                /**
+                 * Writes the leaf leaf_index of the tree committing [first, last) on D with the given step,
+                 * byte for byte as precommit does. polynomial_dfs values must be extended to D.
+                 */
+                template<typename FRI, typename PolynomialIterator, typename OutputIterator>
+                static void write_leaf(PolynomialIterator first, PolynomialIterator last,
+                                       const std::shared_ptr<math::evaluation_domain<typename FRI::field_type>> &D,
+                                       const std::size_t fri_step, const std::size_t leaf_index,
+                                       OutputIterator write_iter) {
+                    using polynomial_type = typename std::iterator_traits<PolynomialIterator>::value_type;
+
+                    std::size_t domain_size = D->size();
+                    std::vector<std::size_t> indices = get_leaf_indices<FRI>(leaf_index, domain_size, 1 << fri_step);
+                    std::vector<typename FRI::field_type::value_type> coset(indices.size());
+                    for (PolynomialIterator it = first; it != last; ++it) {
+                        if constexpr (std::is_same<math::polynomial_dfs<typename FRI::field_type::value_type>,
+                                                   polynomial_type>::value) {
+                            BOOST_ASSERT(it->size() == domain_size);
+                            write_field_elements<FRI>(*it, indices, write_iter);
+                        } else {
+                            for (std::size_t i = 0; i < indices.size(); i++) {
+                                coset[i] = it->evaluate(D->get_domain_element(indices[i]));
+                            }
+                            write_field_elements<FRI>(coset.cbegin(), coset.cend(), write_iter);
+                        }
+                    }
+                }
+
+                /**
+                 * Commits to [first, last) like precommit, keeping only the tree levels at height
+                 * subtree_height and above. The paths are rebuilt by make_proof_specialized from the same
+                 * polynomials, polynomial_dfs ones extended to D by then.
+                 */
+                template<typename FRI, typename PolynomialIterator,
+                        typename std::enable_if<
+                                std::is_base_of<
+                                        commitments::detail::basic_batched_fri<
+                                                typename FRI::field_type, typename FRI::merkle_tree_hash_type,
+                                                typename FRI::transcript_hash_type,
+                                                FRI::lambda, FRI::m,
+                                                FRI::use_grinding, typename FRI::grinding_type>,
+                                        FRI>::value,
+                                bool>::type = true>
+                static typename FRI::capped_precommitment_type
+                precommit_capped(PolynomialIterator first, PolynomialIterator last,
+                                 std::shared_ptr<math::evaluation_domain<typename FRI::field_type>> D,
+                                 const std::size_t fri_step, const std::size_t subtree_height) {
+                    using polynomial_type = typename std::iterator_traits<PolynomialIterator>::value_type;
+                    using polynomial_dfs_type = math::polynomial_dfs<typename FRI::field_type::value_type>;
+
+                    bool extended = false;
+                    if constexpr (std::is_same<polynomial_dfs_type, polynomial_type>::value) {
+                        extended = std::all_of(first, last, [&D](const polynomial_type &poly) {
+                            return poly.size() == D->size();
+                        });
+                    }
+                    if (!extended) {
+                        std::vector<polynomial_dfs_type> poly_dfs(std::distance(first, last));
+                        zk::detail::parallel_for(0, poly_dfs.size(), [&first, &poly_dfs, &D](std::size_t i) {
+                            if constexpr (std::is_same<polynomial_dfs_type, polynomial_type>::value) {
+                                poly_dfs[i] = *std::next(first, i);
+                            } else {
+                                poly_dfs[i].from_coefficients(*std::next(first, i));
+                            }
+                            poly_dfs[i].resize(D->size());
+                        });
+                        return precommit_capped<FRI>(poly_dfs.begin(), poly_dfs.end(), D, fri_step, subtree_height);
+                    } else {
+                        PROFILE_PLACEHOLDER_SCOPE("Basic FRI Precommit time");
+
+                        std::size_t domain_size = D->size();
+                        std::size_t coset_size = 1 << fri_step;
+                        std::size_t leafs_number = domain_size / coset_size;
+                        commitments::detail::flat_leaves_buffer leaves(
+                            leafs_number,
+                            coset_size * FRI::field_element_type::length() * std::distance(first, last));
+
+                        zk::detail::parallel_for(0, leafs_number, [&](std::size_t x_index) {
+                            write_leaf<FRI>(first, last, D, fri_step, x_index, leaves.leaf_begin(x_index));
+                        }, 16);
+
+                        return typename FRI::capped_precommitment_type(leaves, subtree_height);
+                    }
+                }
+
                 template<typename FRI>
                 static inline typename FRI::merkle_proof_type
                 make_proof_specialized(const std::size_t x_index, const std::size_t domain_size,
@@ -435,6 +598,31 @@ namespace nil {
                     return typename FRI::merkle_proof_type(tree, min_x_index);
                 }
 
+                // A full tree holds the path, the committed polynomials are not needed.
+                template<typename FRI, typename PolynomialIterator>
+                static inline typename FRI::merkle_proof_type
+                make_proof_specialized(const std::size_t x_index, const std::size_t domain_size,
+                                       const typename FRI::merkle_tree_type &tree,
+                                       PolynomialIterator, PolynomialIterator,
+                                       const std::shared_ptr<math::evaluation_domain<typename FRI::field_type>> &,
+                                       const std::size_t) {
+                    return make_proof_specialized<FRI>(x_index, domain_size, tree);
+                }
+
+                // The lower part of the path is rebuilt from [first, last), committed on D with fri_step.
+                template<typename FRI, typename PolynomialIterator>
+                static inline typename FRI::merkle_proof_type
+                make_proof_specialized(const std::size_t x_index, const std::size_t domain_size,
+                                       const typename FRI::capped_precommitment_type &tree,
+                                       PolynomialIterator first, PolynomialIterator last,
+                                       const std::shared_ptr<math::evaluation_domain<typename FRI::field_type>> &D,
+                                       const std::size_t fri_step) {
+                    std::size_t min_x_index = std::min(x_index, get_paired_index<FRI>(x_index, domain_size));
+                    return tree.proof(min_x_index, [&](std::size_t leaf_index, auto write_iter) {
+                        write_leaf<FRI>(first, last, D, fri_step, leaf_index, write_iter);
+                    });
+                }
+
                 template<typename FRI>
                 static inline std::size_t get_folded_index(std::size_t x_index, std::size_t domain_size,
                                                            const std::size_t fri_step) {
@@ -445,6 +633,40 @@ namespace nil {
                     return x_index;
                 }
 
+                /**
+                 * Largest fri step, i.e. number of binary folds committed as one Merkle tree. Each leaf of that
+                 * tree holds the whole coset of 2^step points, so the bound keeps leaves at most 1024 points wide.
+                 * check_step_list rejects larger steps and make_step_list caps folding_arity at it.
+                 */
+                constexpr std::size_t fri_max_step = 10;
+
+                /**
+                 * Step list that folds the domain by folding_arity (2, 4, 8, ...) between consecutive Merkle trees.
+                 * A step of log2(folding_arity) binary folds is committed as one tree, whose leaves hold the whole
+                 * coset of folding_arity points, so every round costs one tree and one path per query.
+                 * The last step is 1, as check_step_list requires.
+                 */
+                template<typename FRI>
+                static inline std::vector<std::size_t> make_step_list(std::size_t r, std::size_t folding_arity) {
+                    BOOST_ASSERT(folding_arity >= FRI::m && (folding_arity & (folding_arity - 1)) == 0);
+                    std::size_t step = 0;
+                    while ((std::size_t(FRI::m) << step) <= folding_arity) {
+                        step++;
+                    }
+                    step = std::min(step, fri_max_step);
+
+                    std::vector<std::size_t> step_list;
+                    std::size_t remaining = r;
+                    while (remaining > 1) {
+                        step_list.push_back(std::min(step, remaining - 1));
+                        remaining -= step_list.back();
+                    }
+                    if (remaining == 1) {
+                        step_list.push_back(1);
+                    }
+                    return step_list;
+                }
+
                 template<typename FRI>
                 static inline bool check_step_list(const typename FRI::params_type &fri_params) {
                     if (fri_params.step_list.empty()) {
@@ -457,8 +679,8 @@ namespace nil {
                             // step_list at each layer must be at least 1
                             return false;
                         }
-                        if (fri_params.step_list[i] > 10) {
-                            // step_list at each layer cannot be greater than 10
+                        if (fri_params.step_list[i] > fri_max_step) {
+                            // step_list at each layer cannot be greater than fri_max_step
                             return false;
                         }
                         cumulative_fri_step += fri_params.step_list[i];
@@ -570,7 +792,11 @@ namespace nil {
                  
                 //template<typename FRI, typename PolynomialType>
 
-                template<typename FRI, typename PolynomialType,
+                /**
+                 * PrecommitmentType is FRI::precommitment_type or FRI::capped_precommitment_type. The round trees
+                 * are built of the same type. Paths of capped trees are rebuilt from g and the folded polynomials.
+                 */
+                template<typename FRI, typename PolynomialType, typename PrecommitmentType,
                     typename std::enable_if<
                             std::is_base_of<
                                     commitments::detail::basic_batched_fri<
@@ -583,8 +809,8 @@ namespace nil {
                 static typename FRI::proof_type proof_eval( 
                     std::map<std::size_t, std::vector<PolynomialType>> &g,
                     const PolynomialType combined_Q,
-                    const std::map<std::size_t, typename FRI::precommitment_type> &precommitments,
-                    const typename FRI::precommitment_type &combined_Q_precommitment,
+                    const std::map<std::size_t, PrecommitmentType> &precommitments,
+                    const PrecommitmentType &combined_Q_precommitment,
                     const typename FRI::params_type &fri_params,
                     typename FRI::transcript_type &transcript
                 ) {
@@ -610,8 +836,15 @@ namespace nil {
                     // Commit phase
                     auto f = combined_Q;
                     auto precommitment = combined_Q_precommitment;
+                    if constexpr (std::is_same<math::polynomial_dfs<typename FRI::field_type::value_type>,
+                                               PolynomialType>::value) {
+                        // Capped trees rebuild the paths of the first round from f.
+                        if (f.size() != fri_params.D[0]->size()) {
+                            f.resize(fri_params.D[0]->size());
+                        }
+                    }
 
-                    std::vector<typename FRI::precommitment_type> fri_trees;
+                    std::vector<PrecommitmentType> fri_trees;
                     std::vector<typename FRI::commitment_type> fri_roots;
                     std::vector<typename FRI::field_type::value_type> alphas;
                     std::vector<PolynomialType> fs;
@@ -633,8 +866,22 @@ namespace nil {
                                 f = commitments::detail::fold_polynomial<typename FRI::field_type>(f, alphas[t]);
                             }
                         }
-                        if (i != fri_params.step_list.size() - 1)
-                            precommitment = precommit<FRI>(f, fri_params.D[t], fri_params.step_list[i + 1]);
+                        if (i != fri_params.step_list.size() - 1) {
+                            if constexpr (std::is_same<typename FRI::capped_precommitment_type,
+                                                       PrecommitmentType>::value) {
+                                if constexpr (std::is_same<math::polynomial_dfs<typename FRI::field_type::value_type>,
+                                                           PolynomialType>::value) {
+                                    if (f.size() != fri_params.D[t]->size()) {
+                                        f.resize(fri_params.D[t]->size());
+                                    }
+                                }
+                                precommitment = precommit_capped<FRI>(&f, &f + 1, fri_params.D[t],
+                                                                      fri_params.step_list[i + 1],
+                                                                      fri_params.merkle_subtree_height);
+                            } else {
+                                precommitment = precommit<FRI>(f, fri_params.D[t], fri_params.step_list[i + 1]);
+                            }
+                        }
                     }
                     fs.push_back(f);
                     math::polynomial<typename FRI::field_type::value_type> final_polynomial;
@@ -651,12 +898,20 @@ namespace nil {
                     }
 
                     // Query phase
-                    std::array<typename FRI::query_proof_type, FRI::lambda> query_proofs;
+                    // All the query indices are drawn first, after that the query proofs are independent
+                    // and are built on the thread pool. The proofs only read g, fs and the trees.
+                    std::array<std::uint64_t, FRI::lambda> x_indices;
                     for (std::size_t query_id = 0; query_id < FRI::lambda; query_id++) {
+                        x_indices[query_id] =
+                            (transcript.template int_challenge<std::uint64_t>()) % fri_params.D[0]->size();
+                    }
+
+                    std::array<typename FRI::query_proof_type, FRI::lambda> query_proofs;
+                    zk::detail::parallel_for(0, FRI::lambda, [&](std::size_t query_id) {
                         std::size_t domain_size = fri_params.D[0]->size();
-                        std::uint64_t x_index = (transcript.template int_challenge<std::uint64_t>()) % domain_size;
+                        std::uint64_t x_index = x_indices[query_id];
                         typename FRI::field_type::value_type x = fri_params.D[0]->get_domain_element(x_index);
-                        t = 0;
+                        std::size_t t = 0;
 
                         std::vector<std::array<typename FRI::field_type::value_type, FRI::m>> s;
                         std::vector<std::array<std::size_t, FRI::m>> s_indices;
@@ -666,6 +921,7 @@ namespace nil {
                         std::map<std::size_t, typename FRI::initial_proof_type> initial_proof;
                         for( const auto &it: g ){
                             auto k = it.first;
+                            const std::vector<PolynomialType> &polys = it.second;
                             initial_proof[k] = {};
                             initial_proof[k].values.resize(it.second.size());
                             std::size_t coset_size = 1 << fri_params.step_list[0];
@@ -673,20 +929,19 @@ namespace nil {
                             BOOST_ASSERT(coset_size / FRI::m == s_indices.size());
 
                             //Fill values
-                            t = 0;
-                            for (std::size_t polynomial_index = 0; polynomial_index < g[k].size(); ++polynomial_index) {
+                            for (std::size_t polynomial_index = 0; polynomial_index < polys.size(); ++polynomial_index) {
                                 initial_proof[k].values[polynomial_index].resize(coset_size / FRI::m);
                                 for (std::size_t j = 0; j < coset_size / FRI::m; j++) {
                                     if constexpr (std::is_same<
                                             math::polynomial_dfs<typename FRI::field_type::value_type>,
                                             PolynomialType>::value
                                     ) {
-                                        initial_proof[k].values[polynomial_index][j][0] = std::move(g[k][polynomial_index][s_indices[j][0]]);
-                                        initial_proof[k].values[polynomial_index][j][1] = std::move(g[k][polynomial_index][s_indices[j][1]]);
+                                        initial_proof[k].values[polynomial_index][j][0] = polys[polynomial_index][s_indices[j][0]];
+                                        initial_proof[k].values[polynomial_index][j][1] = polys[polynomial_index][s_indices[j][1]];
                                     } else {
-                                        initial_proof[k].values[polynomial_index][j][0] = g[k][polynomial_index].evaluate(
+                                        initial_proof[k].values[polynomial_index][j][0] = polys[polynomial_index].evaluate(
                                                 s[j][0]);
-                                        initial_proof[k].values[polynomial_index][j][1] = g[k][polynomial_index].evaluate(
+                                        initial_proof[k].values[polynomial_index][j][1] = polys[polynomial_index].evaluate(
                                                 s[j][1]);
                                     }
                                 }
@@ -695,7 +950,8 @@ namespace nil {
                             //Fill merkle proofs
                             initial_proof[k].p = make_proof_specialized<FRI>(
                                 get_folded_index<FRI>(x_index, fri_params.D[0]->size(), fri_params.step_list[0]),
-                                fri_params.D[0]->size(), precommitments.at(k)
+                                fri_params.D[0]->size(), precommitments.at(k),
+                                polys.begin(), polys.end(), fri_params.D[0], fri_params.step_list[0]
                             );
                         }
 
@@ -709,7 +965,8 @@ namespace nil {
                             x = fri_params.D[t]->get_domain_element(x_index);
                             round_proofs[i].p = make_proof_specialized<FRI>(
                                     get_folded_index<FRI>(x_index, domain_size, fri_params.step_list[i]),
-                                    domain_size, fri_trees[i]
+                                    domain_size, fri_trees[i],
+                                    fs.begin() + i, fs.begin() + i + 1, fri_params.D[t], fri_params.step_list[i]
                             );
 
                             t += fri_params.step_list[i];
@@ -743,9 +1000,8 @@ namespace nil {
                                 round_proofs[i].y[0][1] = final_polynomial.evaluate(-x);
                             }
                         }
-                        typename FRI::query_proof_type query_proof = {initial_proof, round_proofs};
-                        query_proofs[query_id] = query_proof;
-                    }
+                        query_proofs[query_id] = {std::move(initial_proof), std::move(round_proofs)};
+                    });
 
                     proof.fri_roots = fri_roots;
                     proof.final_polynomial = final_polynomial;
@@ -754,16 +1010,189 @@ namespace nil {
                 }
 
                 template<typename FRI>
-                static bool verify_eval(
-                    const typename FRI::proof_type                                                  &proof,
+                static std::vector<std::size_t> get_query_batches(const typename FRI::query_proof_type &query_proof) {
+                    std::vector<std::size_t> batches;
+                    for (const auto &it : query_proof.initial_proof) {
+                        batches.push_back(it.first);
+                    }
+                    return batches;
+                }
+
+                template<typename FRI>
+                static std::vector<std::size_t>
+                    get_query_batches(const typename FRI::compressed_query_proof_type &query_proof) {
+                    std::vector<std::size_t> batches;
+                    for (const auto &it : query_proof.initial_values) {
+                        batches.push_back(it.first);
+                    }
+                    return batches;
+                }
+
+                template<typename FRI>
+                static const typename FRI::polynomials_values_type &
+                    get_initial_values(const typename FRI::query_proof_type &query_proof, std::size_t k) {
+                    return query_proof.initial_proof.at(k).values;
+                }
+
+                template<typename FRI>
+                static const typename FRI::polynomials_values_type &
+                    get_initial_values(const typename FRI::compressed_query_proof_type &query_proof, std::size_t k) {
+                    return query_proof.initial_values.at(k);
+                }
+
+                template<typename FRI>
+                static const typename FRI::polynomial_values_type &
+                    get_round_values(const typename FRI::query_proof_type &query_proof, std::size_t i) {
+                    return query_proof.round_proofs.at(i).y;
+                }
+
+                template<typename FRI>
+                static const typename FRI::polynomial_values_type &
+                    get_round_values(const typename FRI::compressed_query_proof_type &query_proof, std::size_t i) {
+                    return query_proof.round_values.at(i);
+                }
+
+                // Validates every Merkle path of a full proof on its own.
+                template<typename FRI>
+                class merkle_path_checker {
+                public:
+                    merkle_path_checker(const typename FRI::proof_type &proof,
+                                        const std::map<std::size_t, typename FRI::commitment_type> &commitments)
+                        : _proof(proof), _commitments(commitments) {
+                    }
+
+                    bool check_initial(std::size_t query_id, std::size_t k, std::size_t,
+                                       const std::vector<std::uint8_t> &leaf_data) const {
+                        const auto &p = _proof.query_proofs[query_id].initial_proof.at(k).p;
+                        return p.root() == _commitments.at(k) && p.validate(leaf_data);
+                    }
+
+                    bool check_round(std::size_t query_id, std::size_t i, std::size_t,
+                                     const std::vector<std::uint8_t> &leaf_data) const {
+                        const auto &p = _proof.query_proofs[query_id].round_proofs[i].p;
+                        return p.root() == _proof.fri_roots[i] && p.validate(leaf_data);
+                    }
+
+                    bool finalize() const {
+                        return true;
+                    }
+
+                private:
+                    const typename FRI::proof_type &_proof;
+                    const std::map<std::size_t, typename FRI::commitment_type> &_commitments;
+                };
+
+                // Collects the leaves of all queries and validates one multi-proof per tree.
+                template<typename FRI>
+                class merkle_multiproof_checker {
+                public:
+                    using node_type = typename FRI::merkle_multiproof_type::node_type;
+
+                    merkle_multiproof_checker(const typename FRI::compressed_proof_type &proof,
+                                              const typename FRI::params_type &fri_params,
+                                              const std::map<std::size_t, typename FRI::commitment_type> &commitments)
+                        : _proof(proof), _commitments(commitments), _round_leaves(fri_params.step_list.size()) {
+                        // A tree of a domain of size 2^n folded by step rounds has 2^(n - step) leaves.
+                        std::size_t t = 0;
+                        for (std::size_t i = 0; i < fri_params.step_list.size(); i++) {
+                            _round_depths.push_back(log2(fri_params.D[t]->size()) - fri_params.step_list[i]);
+                            t += fri_params.step_list[i];
+                        }
+                        _initial_depth = _round_depths.front();
+                    }
+
+                    bool check_initial(std::size_t, std::size_t k, std::size_t leaf_index,
+                                       const std::vector<std::uint8_t> &leaf_data) {
+                        typename FRI::commitment_type leaf_hash = crypto3::hash<typename FRI::merkle_tree_hash_type>(leaf_data);
+                        _initial_leaves[k].emplace_back(leaf_index, leaf_hash);
+                        return true;
+                    }
+
+                    bool check_round(std::size_t, std::size_t i, std::size_t leaf_index,
+                                     const std::vector<std::uint8_t> &leaf_data) {
+                        typename FRI::commitment_type leaf_hash = crypto3::hash<typename FRI::merkle_tree_hash_type>(leaf_data);
+                        _round_leaves[i].emplace_back(leaf_index, leaf_hash);
+                        return true;
+                    }
+
+                    bool finalize() const {
+                        if (_proof.initial_multiproofs.size() != _initial_leaves.size() ||
+                            _proof.round_multiproofs.size() != _round_leaves.size() ||
+                            _proof.fri_roots.size() != _round_leaves.size()) {
+                            return false;
+                        }
+                        for (const auto &[k, leaves] : _initial_leaves) {
+                            auto it = _proof.initial_multiproofs.find(k);
+                            if (it == _proof.initial_multiproofs.end() ||
+                                !it->second.validate(_commitments.at(k), _initial_depth, leaves)) {
+                                return false;
+                            }
+                        }
+                        for (std::size_t i = 0; i < _round_leaves.size(); i++) {
+                            if (!_proof.round_multiproofs[i].validate(_proof.fri_roots[i], _round_depths[i],
+                                                                      _round_leaves[i])) {
+                                return false;
+                            }
+                        }
+                        return true;
+                    }
+
+                private:
+                    static std::size_t log2(std::size_t n) {
+                        std::size_t result = 0;
+                        while ((std::size_t(1) << result) < n) {
+                            result++;
+                        }
+                        return result;
+                    }
+
+                    const typename FRI::compressed_proof_type &_proof;
+                    const std::map<std::size_t, typename FRI::commitment_type> &_commitments;
+                    std::size_t _initial_depth;
+                    std::vector<std::size_t> _round_depths;
+                    std::map<std::size_t, std::vector<node_type>> _initial_leaves;
+                    std::vector<std::vector<node_type>> _round_leaves;
+                };
+
+                /**
+                 * Value at alpha of the line through (s, y[0]) and (-s, y[1]):
+                 * (y[0] + y[1]) / 2 + alpha * (y[0] - y[1]) / (2 * s).
+                 * s is the domain element with index s_index[0], its inverse is the element with index -s_index[0].
+                 */
+                template<typename FRI>
+                static inline typename FRI::field_type::value_type
+                    fold_pair(const typename FRI::polynomial_value_type &y,
+                              const std::array<typename FRI::field_type::value_type, FRI::m> &s,
+                              const std::array<std::size_t, FRI::m> &s_index,
+                              const std::shared_ptr<math::evaluation_domain<typename FRI::field_type>> &D,
+                              const typename FRI::field_type::value_type &alpha,
+                              const typename FRI::field_type::value_type &two_inversed) {
+                    BOOST_ASSERT(s[1] == -s[0]);
+                    std::size_t domain_size = D->size();
+                    typename FRI::field_type::value_type s_inversed =
+                        D->get_domain_element((domain_size - s_index[0] % domain_size) % domain_size);
+                    BOOST_ASSERT(s_inversed * s[0] == FRI::field_type::value_type::one());
+                    return ((y[0] + y[1]) + alpha * (y[0] - y[1]) * s_inversed) * two_inversed;
+                }
+
+                /**
+                 * Checks the queries of a full or a compressed proof. Merkle leaves are passed to the checker,
+                 * which either validates them at once or collects them and validates them in finalize().
+                 */
+                template<typename FRI, typename ProofType, typename MerkleCheckerType>
+                static bool verify_eval_queries(
+                    const ProofType                                                                 &proof,
                     const typename FRI::params_type                                                 &fri_params,
                     const std::map<std::size_t, typename FRI::commitment_type>                      &commitments,
                     const typename FRI::field_type::value_type                                      theta,
                     const std::map<std::size_t, std::vector<std::size_t>>                           &evals_map,
                     const std::vector<math::polynomial<typename FRI::field_type::value_type>>       &combined_U,
                     const std::vector<math::polynomial<typename FRI::field_type::value_type>>       &denominators,
-                    typename FRI::transcript_type &transcript
+                    typename FRI::transcript_type &transcript,
+                    MerkleCheckerType &merkle_checker
                 ) {
+                    using value_type = typename FRI::field_type::value_type;
+
                     BOOST_ASSERT(check_step_list<FRI>(fri_params));
                     BOOST_ASSERT(combined_U.size() == denominators.size());
                     std::size_t evals_num = combined_U.size();
@@ -787,83 +1216,119 @@ namespace nil {
                     if(FRI::use_grinding && !FRI::grinding_type::verify(transcript, proof.proof_of_work)){
                         return false;
                     }
+                    // All the query indices are drawn first, as the prover does.
+                    std::array<std::uint64_t, FRI::lambda> x_indices;
                     for (std::size_t query_id = 0; query_id < FRI::lambda; query_id++) {
-                        const typename FRI::query_proof_type &query_proof = proof.query_proofs[query_id];
+                        x_indices[query_id] =
+                            (transcript.template int_challenge<std::uint64_t>()) % fri_params.D[0]->size();
+                    }
+
+                    // Initial values are combined into (combined g - combined_U) / V at the first coset of
+                    // every query. Numerators and denominators of all queries are collected first and the
+                    // denominators are inverted in one batch.
+                    const std::size_t pairs_num = (std::size_t(1) << fri_params.step_list[0]) / FRI::m;
+                    auto combined_value_id = [evals_num, pairs_num](std::size_t query_id, std::size_t eval_ind,
+                                                                    std::size_t j, std::size_t l) {
+                        return ((query_id * evals_num + eval_ind) * pairs_num + j) * FRI::m + l;
+                    };
+                    std::vector<value_type> combined_numerators(FRI::lambda * evals_num * pairs_num * FRI::m);
+                    std::vector<value_type> combined_denominators(combined_numerators.size());
+
+                    for (std::size_t query_id = 0; query_id < FRI::lambda; query_id++) {
+                        const auto &query_proof = proof.query_proofs[query_id];
 
                         std::size_t domain_size = fri_params.D[0]->size();
                         std::size_t coset_size = 1 << fri_params.step_list[0];
-                        std::uint64_t x_index = (transcript.template int_challenge<std::uint64_t>()) % domain_size;
-                        typename FRI::field_type::value_type x = fri_params.D[0]->get_domain_element(x_index);
+                        std::uint64_t x_index = x_indices[query_id];
+                        value_type x = fri_params.D[0]->get_domain_element(x_index);
 
-                        std::vector<std::array<typename FRI::field_type::value_type, FRI::m>> s;
+                        std::vector<std::array<value_type, FRI::m>> s;
                         std::vector<std::array<std::size_t, FRI::m>> s_indices;
                         std::tie(s, s_indices) = calculate_s<FRI>(x, x_index, fri_params.step_list[0], fri_params.D[0]);
                         auto correct_order_idx = get_correct_order<FRI>(x_index, domain_size, fri_params.step_list[0],
                                                                         s_indices);
 
                         // Check initial proof.
-                        for( auto const it: query_proof.initial_proof ){
-                            auto k = it.first;
-                            if (query_proof.initial_proof.at(k).p.root() != commitments.at(k) ) {
-                                return false;
-                            }
-
-                            std::vector<std::uint8_t> leaf_data(coset_size * FRI::field_element_type::length() * query_proof.initial_proof.at(k).values.size());
+                        for( std::size_t k : get_query_batches<FRI>(query_proof) ){
+                            const typename FRI::polynomials_values_type &values = get_initial_values<FRI>(query_proof, k);
+                            std::vector<std::uint8_t> leaf_data(coset_size * FRI::field_element_type::length() * values.size());
                             auto write_iter = leaf_data.begin();
 
-                            for (std::size_t i = 0; i < query_proof.initial_proof.at(k).values.size(); i++) {
+                            for (std::size_t i = 0; i < values.size(); i++) {
                                 for (auto [idx, pair_idx] : correct_order_idx) {
                                     typename FRI::field_element_type leaf_val0(
-                                        query_proof.initial_proof.at(k).values[i][idx][pair_idx]
+                                        values[i][idx][pair_idx]
                                     );
                                     leaf_val0.write(write_iter, FRI::field_element_type::length());
                                     typename FRI::field_element_type leaf_val1(
-                                        query_proof.initial_proof.at(k).values[i][idx][1-pair_idx]
+                                        values[i][idx][1-pair_idx]
                                     );
                                     leaf_val1.write(write_iter, FRI::field_element_type::length());
                                 }
                             }
-                            if (!query_proof.initial_proof.at(k).p.validate(leaf_data)) {
+                            std::size_t leaf_index = get_folded_index<FRI>(x_index, domain_size, fri_params.step_list[0]);
+                            if (!merkle_checker.check_initial(query_id, k, leaf_index, leaf_data)) {
                                 return false;
                             }
                         }
 
-                        //Calculate combinedQ values
-                        typename FRI::polynomial_values_type y;
-                        typename FRI::polynomial_values_type combined_eval_values;
-                        y.resize(coset_size / FRI::m);
-                        combined_eval_values.resize(coset_size / FRI::m);
-                        for (size_t j = 0; j < coset_size / FRI::m; j++) {
-                            y[j][0] = FRI::field_type::value_type::zero();
-                            y[j][1] = FRI::field_type::value_type::zero();
-                        }
+                        //Calculate combinedQ numerators and denominators
                         for (size_t eval_ind = 0; eval_ind < evals_num; eval_ind++) {
                             std::size_t ind = 0;
-                            for (size_t j = 0; j < coset_size / FRI::m; j++) {
-                                combined_eval_values[j][0] = FRI::field_type::value_type::zero();
-                                combined_eval_values[j][1] = FRI::field_type::value_type::zero();
+                            typename FRI::polynomial_values_type combined_eval_values(pairs_num);
+                            for (size_t j = 0; j < pairs_num; j++) {
+                                combined_eval_values[j][0] = value_type::zero();
+                                combined_eval_values[j][1] = value_type::zero();
                             }
                             for( auto const &it:evals_map ){
                                 auto k = it.first;
-                                for( size_t i = 0; i < query_proof.initial_proof.at(k).values.size(); i++, ind++ ){
-                                    for( size_t j = 0; j < coset_size / FRI::m; j++ ){
+                                const typename FRI::polynomials_values_type &values = get_initial_values<FRI>(query_proof, k);
+                                for( size_t i = 0; i < values.size(); i++, ind++ ){
+                                    for( size_t j = 0; j < pairs_num; j++ ){
                                         combined_eval_values[j][0] *= theta;
                                         combined_eval_values[j][1] *= theta;
                                         if( evals_map.at(k)[i] == eval_ind ){
-                                            combined_eval_values[j][0] += query_proof.initial_proof.at(k).values[i][j][0];
-                                            combined_eval_values[j][1] += query_proof.initial_proof.at(k).values[i][j][1];
+                                            combined_eval_values[j][0] += values[i][j][0];
+                                            combined_eval_values[j][1] += values[i][j][1];
                                         }
                                     }
                                 }
                             }
-                            for (size_t j = 0; j < coset_size / FRI::m; j++) {
-                                combined_eval_values[j][0] -= combined_U[eval_ind].evaluate(s[j][0]);
-                                combined_eval_values[j][1] -= combined_U[eval_ind].evaluate(s[j][1]);
-                                combined_eval_values[j][0] /= denominators[eval_ind].evaluate(s[j][0]);
-                                combined_eval_values[j][1] /= denominators[eval_ind].evaluate(s[j][1]);
+                            for (size_t j = 0; j < pairs_num; j++) {
+                                for (std::size_t l = 0; l < FRI::m; l++) {
+                                    std::size_t id = combined_value_id(query_id, eval_ind, j, l);
+                                    combined_numerators[id] = combined_eval_values[j][l] - combined_U[eval_ind].evaluate(s[j][l]);
+                                    combined_denominators[id] = denominators[eval_ind].evaluate(s[j][l]);
+                                    if (combined_denominators[id] == value_type::zero()) {
+                                        return false;
+                                    }
+                                }
+                            }
+                        }
+                    }
+
+                    zk::detail::batch_inversion(combined_denominators);
+                    const value_type two_inversed = value_type(2).inversed();
 
-                                y[j][0] += combined_eval_values[j][0];
-                                y[j][1] += combined_eval_values[j][1];
+                    for (std::size_t query_id = 0; query_id < FRI::lambda; query_id++) {
+                        const auto &query_proof = proof.query_proofs[query_id];
+
+                        std::size_t domain_size = fri_params.D[0]->size();
+                        std::size_t coset_size = 1 << fri_params.step_list[0];
+                        std::uint64_t x_index = x_indices[query_id];
+                        value_type x = fri_params.D[0]->get_domain_element(x_index);
+
+                        std::vector<std::array<value_type, FRI::m>> s;
+                        std::vector<std::array<std::size_t, FRI::m>> s_indices;
+
+                        typename FRI::polynomial_values_type y(pairs_num);
+                        for (size_t j = 0; j < pairs_num; j++) {
+                            for (std::size_t l = 0; l < FRI::m; l++) {
+                                y[j][l] = value_type::zero();
+                                for (size_t eval_ind = 0; eval_ind < evals_num; eval_ind++) {
+                                    std::size_t id = combined_value_id(query_id, eval_ind, j, l);
+                                    y[j][l] += combined_numerators[id] * combined_denominators[id];
+                                }
                             }
                         }
 
@@ -872,7 +1337,6 @@ namespace nil {
                         typename FRI::polynomial_values_type y_next;
                         for (std::size_t i = 0; i < fri_params.step_list.size(); i++) {
                             coset_size = 1 << fri_params.step_list[i];
-                            if (query_proof.round_proofs[i].p.root() != proof.fri_roots[i]) return false;
 
                             std::tie(s, s_indices) = calculate_s<FRI>(x, x_index, fri_params.step_list[i],
                                                                       fri_params.D[t]);
@@ -886,7 +1350,8 @@ namespace nil {
                                 typename FRI::field_element_type leaf_val1(y[idx][1 - pair_idx]);
                                 leaf_val1.write(write_iter, FRI::field_element_type::length());
                             }
-                            if (!query_proof.round_proofs[i].p.validate(leaf_data)) {
+                            std::size_t leaf_index = get_folded_index<FRI>(x_index, domain_size, fri_params.step_list[i]);
+                            if (!merkle_checker.check_round(query_id, i, leaf_index, leaf_data)) {
                                 return false;
                             }
 
@@ -900,21 +1365,12 @@ namespace nil {
                                 std::tie(s, s_indices) = calculate_s<FRI>(x, x_index, fri_params.step_list[i],
                                                                           fri_params.D[t]);
                                 for (std::size_t y_ind = 0; y_ind < y_next.size(); y_ind++) {
-                                    std::vector<std::pair<typename FRI::field_type::value_type, typename FRI::field_type::value_type>> interpolation_points_l{
-                                            std::make_pair(s[2 * y_ind][0], y[2 * y_ind][0]),
-                                            std::make_pair(s[2 * y_ind][1], y[2 * y_ind][1]),
-                                    };
-                                    math::polynomial<typename FRI::field_type::value_type> interpolant_l =
-                                            math::lagrange_interpolation(interpolation_points_l);
-                                    y_next[y_ind][0] = interpolant_l.evaluate(alphas[t]);
-
-                                    std::vector<std::pair<typename FRI::field_type::value_type, typename FRI::field_type::value_type>> interpolation_points_r{
-                                            std::make_pair(s[2 * y_ind + 1][0], y[2 * y_ind + 1][0]),
-                                            std::make_pair(s[2 * y_ind + 1][1], y[2 * y_ind + 1][1]),
-                                    };
-                                    math::polynomial<typename FRI::field_type::value_type> interpolant_r =
-                                            math::lagrange_interpolation(interpolation_points_r);
-                                    y_next[y_ind][1] = interpolant_r.evaluate(alphas[t]);
+                                    y_next[y_ind][0] = fold_pair<FRI>(
+                                        y[2 * y_ind], s[2 * y_ind], s_indices[2 * y_ind], fri_params.D[t], alphas[t],
+                                        two_inversed);
+                                    y_next[y_ind][1] = fold_pair<FRI>(
+                                        y[2 * y_ind + 1], s[2 * y_ind + 1], s_indices[2 * y_ind + 1], fri_params.D[t],
+                                        alphas[t], two_inversed);
                                 }
                                 x = x * x;
                                 y = y_next;
@@ -922,20 +1378,16 @@ namespace nil {
                             std::tie(s, s_indices) = calculate_s<FRI>(x, x_index, fri_params.step_list[i],
                                                                       fri_params.D[t]);
 
-                            std::vector<std::pair<typename FRI::field_type::value_type, typename FRI::field_type::value_type>> interpolation_points{
-                                    std::make_pair(s[0][0], y[0][0]),
-                                    std::make_pair(s[0][1], y[0][1]),
-                            };
-                            math::polynomial<typename FRI::field_type::value_type> interpolant_poly =
-                                    math::lagrange_interpolation(interpolation_points);
-                            auto interpolant = interpolant_poly.evaluate(alphas[t]);
-                            if (interpolant != query_proof.round_proofs[i].y[0][0]) {
+                            value_type interpolant =
+                                fold_pair<FRI>(y[0], s[0], s_indices[0], fri_params.D[t], alphas[t], two_inversed);
+                            const typename FRI::polynomial_values_type &round_values = get_round_values<FRI>(query_proof, i);
+                            if (interpolant != round_values[0][0]) {
                                 return false;
                             }
 
                             // For the last round we check final polynomial nor colinear_check
                             t++;
-                            y = query_proof.round_proofs[i].y;
+                            y = round_values;
                             if (i < fri_params.step_list.size() - 1) {
                                 domain_size = fri_params.D[t]->size();
                                 x_index %= domain_size;
@@ -952,7 +1404,78 @@ namespace nil {
                         }
                     }
 
-                    return true;
+                    return merkle_checker.finalize();
+                }
+
+                template<typename FRI>
+                static bool verify_eval(
+                    const typename FRI::proof_type                                                  &proof,
+                    const typename FRI::params_type                                                 &fri_params,
+                    const std::map<std::size_t, typename FRI::commitment_type>                      &commitments,
+                    const typename FRI::field_type::value_type                                      theta,
+                    const std::map<std::size_t, std::vector<std::size_t>>                           &evals_map,
+                    const std::vector<math::polynomial<typename FRI::field_type::value_type>>       &combined_U,
+                    const std::vector<math::polynomial<typename FRI::field_type::value_type>>       &denominators,
+                    typename FRI::transcript_type &transcript
+                ) {
+                    merkle_path_checker<FRI> merkle_checker(proof, commitments);
+                    return verify_eval_queries<FRI>(proof, fri_params, commitments, theta, evals_map, combined_U,
+                                                    denominators, transcript, merkle_checker);
+                }
+
+                template<typename FRI>
+                static bool verify_eval(
+                    const typename FRI::compressed_proof_type                                       &proof,
+                    const typename FRI::params_type                                                 &fri_params,
+                    const std::map<std::size_t, typename FRI::commitment_type>                      &commitments,
+                    const typename FRI::field_type::value_type                                      theta,
+                    const std::map<std::size_t, std::vector<std::size_t>>                           &evals_map,
+                    const std::vector<math::polynomial<typename FRI::field_type::value_type>>       &combined_U,
+                    const std::vector<math::polynomial<typename FRI::field_type::value_type>>       &denominators,
+                    typename FRI::transcript_type &transcript
+                ) {
+                    if (proof.fri_roots.size() != fri_params.step_list.size()) {
+                        return false;
+                    }
+                    for (const auto &query_proof : proof.query_proofs) {
+                        if (query_proof.round_values.size() != fri_params.step_list.size()) {
+                            return false;
+                        }
+                    }
+                    merkle_multiproof_checker<FRI> merkle_checker(proof, fri_params, commitments);
+                    return verify_eval_queries<FRI>(proof, fri_params, commitments, theta, evals_map, combined_U,
+                                                    denominators, transcript, merkle_checker);
+                }
+
+                // Moves the Merkle paths of all queries into one multi-proof per tree.
+                template<typename FRI>
+                static typename FRI::compressed_proof_type compress_proof(const typename FRI::proof_type &proof) {
+                    typename FRI::compressed_proof_type result;
+                    result.fri_roots = proof.fri_roots;
+                    result.final_polynomial = proof.final_polynomial;
+                    result.proof_of_work = proof.proof_of_work;
+
+                    std::map<std::size_t, std::vector<typename FRI::merkle_proof_type>> initial_paths;
+                    std::vector<std::vector<typename FRI::merkle_proof_type>> round_paths(proof.fri_roots.size());
+                    for (std::size_t query_id = 0; query_id < FRI::lambda; query_id++) {
+                        const typename FRI::query_proof_type &query_proof = proof.query_proofs[query_id];
+                        for (const auto &[k, initial_proof] : query_proof.initial_proof) {
+                            result.query_proofs[query_id].initial_values[k] = initial_proof.values;
+                            initial_paths[k].push_back(initial_proof.p);
+                        }
+                        for (std::size_t i = 0; i < query_proof.round_proofs.size(); i++) {
+                            result.query_proofs[query_id].round_values.push_back(query_proof.round_proofs[i].y);
+                            round_paths[i].push_back(query_proof.round_proofs[i].p);
+                        }
+                    }
+
+                    for (const auto &[k, paths] : initial_paths) {
+                        result.initial_multiproofs[k] = FRI::merkle_multiproof_type::from_proofs(paths);
+                    }
+                    for (const auto &paths : round_paths) {
+                        result.round_multiproofs.push_back(FRI::merkle_multiproof_type::from_proofs(paths));
+                    }
+                    return result;
                 }
             }    // namespace algorithms
         }        // namespace zk
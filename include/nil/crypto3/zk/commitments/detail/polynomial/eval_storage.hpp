@@ -25,6 +25,12 @@
 #ifndef CRYPTO3_ZK_PLACEHOLDER_EVAL_STORAGE_HPP
 #define CRYPTO3_ZK_PLACEHOLDER_EVAL_STORAGE_HPP
 
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/assert.hpp>
+
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 #include <nil/crypto3/zk/commitments/type_traits.hpp>
 
@@ -32,69 +38,252 @@ namespace nil {
     namespace crypto3 {
         namespace zk {
             namespace commitments {
+                /**
+                 * Values of the committed polynomials at their evaluation points, z[batch][poly][point].
+                 * All the values are kept in one array ordered by batch id, polynomial and point, the values
+                 * of a polynomial are found through a table of offsets. get() is two lookups in vectors.
+                 */
                 template<typename FieldType>
                 class eval_storage{
-                private:
-                    std::map<std::size_t, std::vector<std::vector<typename FieldType::value_type>>> z;
                 public:
                     using field_type = FieldType;
-                    
-                    bool operator==(const eval_storage& other) const{
-                        return this->z == other.z;
+                    using value_type = typename FieldType::value_type;
+
+                    // Values of one polynomial, valid until the storage is modified.
+                    class poly_view {
+                    public:
+                        poly_view(const value_type *data, std::size_t size) : _data(data), _size(size) {
+                        }
+
+                        std::size_t size() const {
+                            return _size;
+                        }
+                        const value_type &operator[](std::size_t point_id) const {
+                            BOOST_ASSERT(point_id < _size);
+                            return _data[point_id];
+                        }
+                        const value_type *begin() const {
+                            return _data;
+                        }
+                        const value_type *end() const {
+                            return _data + _size;
+                        }
+                        operator std::vector<value_type>() const {
+                            return std::vector<value_type>(begin(), end());
+                        }
+
+                    private:
+                        const value_type *_data;
+                        std::size_t _size;
+                    };
+
+                    // Values of the polynomials of one batch, valid until the storage is modified.
+                    class batch_view {
+                    public:
+                        batch_view(const eval_storage *storage, std::size_t first_poly, std::size_t size)
+                            : _storage(storage), _first_poly(first_poly), _size(size) {
+                        }
+
+                        std::size_t size() const {
+                            return _size;
+                        }
+                        poly_view operator[](std::size_t poly_id) const {
+                            BOOST_ASSERT(poly_id < _size);
+                            return _storage->poly(_first_poly + poly_id);
+                        }
+                        operator std::vector<std::vector<value_type>>() const {
+                            std::vector<std::vector<value_type>> result;
+                            result.reserve(_size);
+                            for (std::size_t i = 0; i < _size; i++) {
+                                result.emplace_back((*this)[i]);
+                            }
+                            return result;
+                        }
+
+                    private:
+                        const eval_storage *_storage;
+                        std::size_t _first_poly;
+                        std::size_t _size;
+                    };
+
+                    // Batch ids index the offset tables directly, larger ids are rejected before allocating.
+                    static constexpr std::size_t max_batch_id = 1024;
+
+                    eval_storage() : _poly_offsets(1, 0) {
                     }
-                    eval_storage &operator=(const eval_storage& other){
-                        this->z = other.z;
-                        return *this;
+
+                    // Takes the values in the storage order with the number of points of every polynomial
+                    // of every batch, so that decoded proofs are not copied value by value.
+                    eval_storage(const std::map<std::size_t, std::vector<std::size_t>> &points_numbers,
+                                 std::vector<value_type> &&values)
+                        : _poly_offsets(1, 0), _values(std::move(values)) {
+                        for (auto const &[batch_id, poly_points] : points_numbers) {
+                            reserve_batch(batch_id);
+                            _batch_first[batch_id] = _poly_offsets.size() - 1;
+                            _batch_size[batch_id] = poly_points.size();
+                            _batches_num++;
+                            for (std::size_t points_number : poly_points) {
+                                _poly_offsets.push_back(_poly_offsets.back() + points_number);
+                            }
+                        }
+                        if (_poly_offsets.back() != _values.size()) {
+                            throw std::invalid_argument("eval_storage: values number does not match the points numbers");
+                        }
+                    }
+
+                    eval_storage(const eval_storage &other) = default;
+                    eval_storage(eval_storage &&other) = default;
+                    eval_storage &operator=(const eval_storage &other) = default;
+                    eval_storage &operator=(eval_storage &&other) = default;
+
+                    bool operator==(const eval_storage& other) const{
+                        return this->get_batch_info() == other.get_batch_info() &&
+                               this->_poly_offsets == other._poly_offsets && this->_values == other._values;
                     }
                     std::vector<std::size_t> get_batches() const{
                         std::vector<std::size_t> batches;
 
-                        for(auto it = z.begin(); it != z.end(); ++it){
-                            batches.push_back(it->first);
+                        for (std::size_t batch_id = 0; batch_id < _batch_first.size(); batch_id++) {
+                            if (_batch_first[batch_id] != npos) {
+                                batches.push_back(batch_id);
+                            }
                         }
                         return batches;
                     }
                     std::map<std::size_t, std::size_t> get_batch_info() const{
                         std::map<std::size_t, std::size_t> batch_info;
 
-                        for(auto it = z.begin(); it != z.end(); ++it){
-                            batch_info[it->first] = it->second.size();
+                        for (std::size_t batch_id : get_batches()) {
+                            batch_info[batch_id] = _batch_size[batch_id];
                         }
                         return batch_info;
                     }
                     std::size_t get_batches_num() const{
-                        return z.size();
+                        return _batches_num;
                     }
                     std::size_t get_batch_size(std::size_t batch_id) const{
-                        return z.at(batch_id).size();
+                        return _batch_size[batch_index(batch_id)];
                     }
                     std::size_t get_poly_points_number(std::size_t batch_id, std::size_t poly_id) const{
-                        return z.at(batch_id)[poly_id].size();
+                        std::size_t index = poly_index(batch_id, poly_id);
+                        return _poly_offsets[index + 1] - _poly_offsets[index];
+                    }
+                    batch_view get(std::size_t batch_id) const{
+                        std::size_t index = batch_index(batch_id);
+                        return batch_view(this, _batch_first[index], _batch_size[index]);
                     }
-                    const std::vector<std::vector<typename FieldType::value_type>> &get(std::size_t batch_id) const{
-                        return z.at(batch_id);
+                    poly_view get(std::size_t batch_id, std::size_t poly_id) const{
+                        return poly(poly_index(batch_id, poly_id));
                     }
-                    const std::vector<typename FieldType::value_type> &get(std::size_t batch_id, std::size_t poly_id) const{
-                        return z.at(batch_id)[poly_id];
+                    const value_type &get(std::size_t batch_id, std::size_t poly_id, size_t point_id) const{
+                        std::size_t index = poly_index(batch_id, poly_id);
+                        BOOST_ASSERT(_poly_offsets[index] + point_id < _poly_offsets[index + 1]);
+                        return _values[_poly_offsets[index] + point_id];
                     }
-                    const typename FieldType::value_type &get(std::size_t batch_id, std::size_t poly_id, size_t point_id) const{
-                        return z.at(batch_id)[poly_id][point_id];
+
+                    // All the values in the storage order, batches by increasing id.
+                    const std::vector<value_type> &values() const {
+                        return _values;
                     }
 
+                    // Batches are kept in the order of their ids, so filling them by increasing id only appends.
                     void set_batch_size(std::size_t batch_id, std::size_t batch_size){
-                        z[batch_id] = {};
-                        z[batch_id].resize(batch_size);
+                        reserve_batch(batch_id);
+
+                        std::size_t first = _batch_first[batch_id];
+                        if (first == npos) {
+                            first = _poly_offsets.size() - 1;
+                            for (std::size_t next = batch_id + 1; next < _batch_first.size(); next++) {
+                                if (_batch_first[next] != npos) {
+                                    first = _batch_first[next];
+                                    break;
+                                }
+                            }
+                            _batches_num++;
+                        } else {
+                            // The polynomials of the batch are removed with their values.
+                            std::size_t old_size = _batch_size[batch_id];
+                            std::size_t removed_values = _poly_offsets[first + old_size] - _poly_offsets[first];
+                            _values.erase(_values.begin() + _poly_offsets[first],
+                                          _values.begin() + _poly_offsets[first + old_size]);
+                            _poly_offsets.erase(_poly_offsets.begin() + first + 1,
+                                                _poly_offsets.begin() + first + 1 + old_size);
+                            for (std::size_t i = first + 1; i < _poly_offsets.size(); i++) {
+                                _poly_offsets[i] -= removed_values;
+                            }
+                            shift_batches(batch_id, -std::ptrdiff_t(old_size));
+                        }
+
+                        // Polynomials without points.
+                        _poly_offsets.insert(_poly_offsets.begin() + first, batch_size, _poly_offsets[first]);
+                        shift_batches(batch_id, std::ptrdiff_t(batch_size));
+                        _batch_first[batch_id] = first;
+                        _batch_size[batch_id] = batch_size;
                     }
                     void set_poly_points_number(std::size_t batch_id, std::size_t poly_id, std::size_t points_number){
-                        z[batch_id][poly_id] = {};
-                        z[batch_id][poly_id].resize(points_number);
+                        std::size_t index = poly_index(batch_id, poly_id);
+                        std::size_t begin = _poly_offsets[index];
+                        std::size_t old_points_number = _poly_offsets[index + 1] - begin;
+
+                        _values.erase(_values.begin() + begin, _values.begin() + begin + old_points_number);
+                        _values.insert(_values.begin() + begin, points_number, value_type());
+                        for (std::size_t i = index + 1; i < _poly_offsets.size(); i++) {
+                            _poly_offsets[i] = _poly_offsets[i] - old_points_number + points_number;
+                        }
+                    }
+                    void set(std::size_t batch_id, std::size_t poly_id, size_t point_id, const value_type &value){
+                        std::size_t index = poly_index(batch_id, poly_id);
+                        BOOST_ASSERT(_poly_offsets[index] + point_id < _poly_offsets[index + 1]);
+                        _values[_poly_offsets[index] + point_id] = value;
                     }
-                    void set(std::size_t batch_id, std::size_t poly_id, size_t point_id, const typename FieldType::value_type &value){
-                        z[batch_id][poly_id][point_id] = value;
+
+                private:
+                    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+                    // Throws std::out_of_range for a missing batch, as std::map::at did.
+                    std::size_t batch_index(std::size_t batch_id) const {
+                        if (batch_id >= _batch_first.size() || _batch_first[batch_id] == npos) {
+                            throw std::out_of_range("eval_storage: no such batch");
+                        }
+                        return batch_id;
+                    }
+                    // Throws std::invalid_argument for ids above max_batch_id, which may come from a decoded proof.
+                    void reserve_batch(std::size_t batch_id) {
+                        if (batch_id > max_batch_id) {
+                            throw std::invalid_argument("eval_storage: batch id is too large");
+                        }
+                        if (_batch_first.size() <= batch_id) {
+                            _batch_first.resize(batch_id + 1, npos);
+                            _batch_size.resize(batch_id + 1, 0);
+                        }
+                    }
+                    std::size_t poly_index(std::size_t batch_id, std::size_t poly_id) const {
+                        BOOST_ASSERT(poly_id < _batch_size[batch_index(batch_id)]);
+                        return _batch_first[batch_id] + poly_id;
+                    }
+                    poly_view poly(std::size_t index) const {
+                        return poly_view(_values.data() + _poly_offsets[index],
+                                         _poly_offsets[index + 1] - _poly_offsets[index]);
                     }
+                    // Moves the polynomials of the batches after batch_id.
+                    void shift_batches(std::size_t batch_id, std::ptrdiff_t shift) {
+                        for (std::size_t next = batch_id + 1; next < _batch_first.size(); next++) {
+                            if (_batch_first[next] != npos) {
+                                _batch_first[next] += shift;
+                            }
+                        }
+                    }
+
+                    // Index of the first polynomial of a batch in _poly_offsets, npos for missing batches.
+                    std::vector<std::size_t> _batch_first;
+                    std::vector<std::size_t> _batch_size;
+                    std::size_t _batches_num = 0;
+                    // The values of polynomial i are _values[_poly_offsets[i] .. _poly_offsets[i + 1]).
+                    std::vector<std::size_t> _poly_offsets;
+                    std::vector<value_type> _values;
                 };
             }
         }
     }
 }
-#endif
\ No newline at end of file
+#endif
@@ -39,6 +39,7 @@
 #include <nil/crypto3/container/merkle/proof.hpp>
 
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
+#include <nil/crypto3/zk/detail/parallelization.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -84,12 +85,14 @@ namespace nil {
                         two_inversed = two_inversed.inversed();
                         typename FieldType::value_type omega_inversed = domain->get_domain_element(domain->size() - 1);
 
-                        typename FieldType::value_type acc = alpha;
-
-                        for (std::size_t i = 0; i <= f_folded.degree(); i++) {
-                            f_folded[i] = two_inversed * ((1 + acc) * f[i] + (1 - acc) * f[domain->size() / 2 + i]);
-                            acc *= omega_inversed;
-                        }
+                        // Each chunk starts from its own power of omega^{-1}.
+                        zk::detail::parallel_for_chunks(0, f_folded.size(), [&](std::size_t begin, std::size_t end) {
+                            typename FieldType::value_type acc = alpha * omega_inversed.pow(begin);
+                            for (std::size_t i = begin; i < end; i++) {
+                                f_folded[i] = two_inversed * ((1 + acc) * f[i] + (1 - acc) * f[domain->size() / 2 + i]);
+                                acc *= omega_inversed;
+                            }
+                        }, 1024);
 
                         return f_folded;
                     }
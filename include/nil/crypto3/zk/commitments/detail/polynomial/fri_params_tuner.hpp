@@ -0,0 +1,346 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Choice of FRI parameters by estimated prover time, proof size and verifier cost.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_COMMITMENTS_FRI_PARAMS_TUNER_HPP
+#define CRYPTO3_ZK_COMMITMENTS_FRI_PARAMS_TUNER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <nil/crypto3/hash/algorithm/hash.hpp>
+
+#include <nil/crypto3/math/algorithms/calculate_domain_set.hpp>
+
+#include <nil/crypto3/zk/detail/thread_pool.hpp>
+#include <nil/crypto3/zk/commitments/detail/polynomial/basic_fri.hpp>
+#include <nil/crypto3/zk/commitments/detail/polynomial/proof_of_work.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace commitments {
+
+                /**
+                 * @brief Host costs of the FRI building blocks in seconds, single-threaded.
+                 * measure() calibrates them with a short micro-benchmark.
+                 */
+                struct fri_cost_model {
+                    // Seconds per field multiplication.
+                    double field_mul = 0;
+                    // Seconds per hashed block of hash_block_bytes bytes.
+                    double hash_block = 0;
+                    std::size_t hash_block_bytes = 64;
+                    // Threads the prover work is spread over.
+                    std::size_t threads = 1;
+
+                    template<typename FieldType, typename HashType>
+                    static fri_cost_model measure(std::size_t iterations = 1 << 16) {
+                        using clock_type = std::chrono::steady_clock;
+                        using value_type = typename FieldType::value_type;
+
+                        fri_cost_model result;
+                        result.threads = zk::detail::thread_pool::instance().size();
+
+                        value_type a = value_type(3);
+                        value_type b = value_type(5).inversed();
+                        auto start = clock_type::now();
+                        for (std::size_t i = 0; i < iterations; i++) {
+                            a *= b;
+                        }
+                        std::chrono::duration<double> elapsed = clock_type::now() - start;
+                        result.field_mul = elapsed.count() / iterations;
+                        // Keeps the loop observable.
+                        if (a == value_type::zero()) {
+                            result.field_mul *= 2;
+                        }
+
+                        // Messages of 16 blocks, about the size of FRI leaves.
+                        const std::size_t message_blocks = 16;
+                        std::vector<std::uint8_t> message(message_blocks * result.hash_block_bytes, 0x5a);
+                        std::size_t hashes_number = std::max<std::size_t>(iterations / (16 * message_blocks), 1);
+                        typename HashType::digest_type digest = hash<HashType>(message);
+                        std::size_t repeated = 0;
+                        start = clock_type::now();
+                        for (std::size_t i = 0; i < hashes_number; i++) {
+                            message[i % message.size()]++;
+                            typename HashType::digest_type next = hash<HashType>(message);
+                            repeated += (next == digest);
+                            digest = next;
+                        }
+                        elapsed = clock_type::now() - start;
+                        result.hash_block = elapsed.count() / (hashes_number * result.hash_blocks(message.size()));
+                        if (repeated == hashes_number) {
+                            result.hash_block *= 2;
+                        }
+                        return result;
+                    }
+
+                    // Blocks hashed for a message of the given length, padding included.
+                    std::size_t hash_blocks(std::size_t bytes) const {
+                        return bytes / hash_block_bytes + 1;
+                    }
+                };
+
+                // What the parameters are chosen for.
+                struct fri_tuning_request {
+                    // Conjectured security of the FRI low-degree test.
+                    std::size_t security_bits = 100;
+                    // Rows of the committed columns, a power of two.
+                    std::size_t rows = 0;
+                    std::size_t batches_num = 1;
+                    // Polynomials of all batches together.
+                    std::size_t polys_num = 1;
+
+                    std::size_t max_expand_factor = 8;
+                    std::size_t max_grinding_bits = 24;
+                    std::size_t max_lambda = 256;
+                };
+
+                // One parameter choice and its estimated costs.
+                struct fri_tuning_choice {
+                    std::size_t lambda;
+                    // Log2 of the blowup: the FRI domain has rows << expand_factor points.
+                    std::size_t expand_factor;
+                    // Counted in security_bits but not set by make_fri_params: the FRI type has to grind with
+                    // proof_of_work_bits<TranscriptHashType, grinding_bits>, see fri_grinding_type.
+                    std::size_t grinding_bits;
+                    std::size_t r;
+                    std::vector<std::size_t> step_list;
+
+                    std::size_t security_bits;
+                    double prover_seconds;
+                    std::size_t proof_bytes;
+                    double verifier_seconds;
+
+                    bool dominates(const fri_tuning_choice &other) const {
+                        bool not_worse = prover_seconds <= other.prover_seconds &&
+                                         proof_bytes <= other.proof_bytes &&
+                                         verifier_seconds <= other.verifier_seconds;
+                        bool better = prover_seconds < other.prover_seconds || proof_bytes < other.proof_bytes ||
+                                      verifier_seconds < other.verifier_seconds;
+                        return not_worse && better;
+                    }
+                };
+
+                /**
+                 * Grinding type for the GrindingType parameter of the FRI types that matches the grinding_bits
+                 * of a choice. Zero bits mean no grinding, UseGrinding should then be false.
+                 */
+                template<typename TranscriptHashType, std::size_t GrindingBits>
+                using fri_grinding_type = proof_of_work_bits<TranscriptHashType, GrindingBits>;
+            }    // namespace commitments
+
+            namespace algorithms {
+
+                /**
+                 * Estimated costs of one parameter choice for the request, see tune_fri_params.
+                 * Prover: LDE of all polynomials, the combined quotient, all Merkle trees, folding and grinding,
+                 * spread over the model threads. Proof: query values, Merkle paths, roots, the final polynomial
+                 * and the nonce. Verifier: leaf and path hashing and the per-query folding.
+                 */
+                template<typename FRI>
+                static commitments::fri_tuning_choice
+                    estimate_fri_costs(const commitments::fri_tuning_request &request,
+                                       const commitments::fri_cost_model &model, std::size_t lambda,
+                                       std::size_t expand_factor, std::size_t grinding_bits, std::size_t r,
+                                       const std::vector<std::size_t> &step_list) {
+                    const std::size_t element_bytes = FRI::field_element_type::length();
+                    const std::size_t digest_bytes = FRI::merkle_tree_hash_type::digest_bits / 8;
+
+                    std::size_t rows_log = 0;
+                    while ((std::size_t(1) << rows_log) < request.rows) {
+                        rows_log++;
+                    }
+                    const std::size_t domain_log = rows_log + expand_factor;
+                    const double domain_size = double(std::size_t(1) << domain_log);
+                    const double node_hash = model.hash_block * model.hash_blocks(2 * digest_bytes);
+
+                    commitments::fri_tuning_choice choice;
+                    choice.lambda = lambda;
+                    choice.expand_factor = expand_factor;
+                    choice.grinding_bits = grinding_bits;
+                    choice.r = r;
+                    choice.step_list = step_list;
+                    choice.security_bits = std::min<std::size_t>(
+                        lambda * expand_factor + grinding_bits,
+                        FRI::field_type::modulus_bits > domain_log ? FRI::field_type::modulus_bits - domain_log : 0);
+
+                    // Prover
+                    double prover = 0;
+                    prover += request.polys_num * domain_size * domain_log / 2 * model.field_mul;
+                    prover += request.polys_num * domain_size * 3 * model.field_mul;
+                    double batch_leaves = domain_size / double(std::size_t(1) << step_list[0]);
+                    prover += request.polys_num * domain_size * element_bytes / model.hash_block_bytes * model.hash_block;
+                    prover += request.batches_num * batch_leaves * (model.hash_block + node_hash);
+
+                    double round_domain = domain_size;
+                    for (std::size_t i = 0; i < step_list.size(); i++) {
+                        double coset_size = double(std::size_t(1) << step_list[i]);
+                        double leaves = round_domain / coset_size;
+                        prover += leaves * (model.hash_blocks(coset_size * element_bytes) * model.hash_block + node_hash);
+                        for (std::size_t step = 0; step < step_list[i]; step++) {
+                            prover += round_domain / 2 * 3 * model.field_mul;
+                            round_domain /= 2;
+                        }
+                    }
+                    prover /= double(std::max<std::size_t>(model.threads, 1));
+                    prover += double(std::uint64_t(1) << grinding_bits) * 2 * model.hash_block /
+                              double(std::max<std::size_t>(model.threads, 1));
+                    choice.prover_seconds = prover;
+
+                    // Proof size and verifier
+                    std::size_t query_bytes = 0;
+                    double query_seconds = 0;
+                    std::size_t coset_size = std::size_t(1) << step_list[0];
+                    std::size_t depth = domain_log - step_list[0];
+                    query_bytes += request.polys_num * coset_size * element_bytes;
+                    query_bytes += request.batches_num * depth * digest_bytes;
+                    query_seconds += request.batches_num * depth * node_hash;
+                    query_seconds += model.hash_blocks(request.polys_num * coset_size * element_bytes) * model.hash_block;
+                    query_seconds += request.polys_num * coset_size * 2 * model.field_mul;
+
+                    std::size_t round_log = domain_log;
+                    for (std::size_t i = 0; i < step_list.size(); i++) {
+                        coset_size = std::size_t(1) << step_list[i];
+                        depth = round_log - step_list[i];
+                        std::size_t next_values = (i + 1 < step_list.size()) ? (std::size_t(1) << step_list[i + 1]) : FRI::m;
+                        query_bytes += depth * digest_bytes + next_values * element_bytes;
+                        query_seconds += depth * node_hash +
+                                         model.hash_blocks(coset_size * element_bytes) * model.hash_block +
+                                         coset_size * 4 * model.field_mul;
+                        round_log -= step_list[i];
+                    }
+
+                    std::size_t final_polynomial_size = std::size_t(1) << (rows_log - r + 1);
+                    choice.proof_bytes = lambda * query_bytes + step_list.size() * digest_bytes +
+                                         final_polynomial_size * element_bytes + sizeof(std::uint64_t);
+                    choice.verifier_seconds = lambda * (query_seconds + final_polynomial_size * 2 * model.field_mul) +
+                                              (grinding_bits > 0 ? 2 * model.hash_block : 0);
+                    return choice;
+                }
+
+                /**
+                 * Pareto set of FRI parameters reaching request.security_bits, ordered by prover time.
+                 * Security is the conjectured lambda * expand_factor + grinding_bits, bounded by the field size.
+                 * Candidates vary the blowup, the grinding bits, the final polynomial size (through r) and the
+                 * folding arity of make_step_list. A choice is kept unless another one is no worse in prover
+                 * time, proof size and verifier cost, and better in one of them.
+                 * lambda and the grinding are template parameters of the FRI types, the scheme is instantiated
+                 * with the chosen lambda and with UseGrinding and fri_grinding_type for the chosen grinding_bits.
+                 * Without them the proof has the security of lambda * expand_factor only.
+                 */
+                template<typename FRI>
+                static std::vector<commitments::fri_tuning_choice>
+                    tune_fri_params(const commitments::fri_tuning_request &request,
+                                    const commitments::fri_cost_model &model) {
+                    BOOST_ASSERT(request.rows >= 4 && (request.rows & (request.rows - 1)) == 0);
+
+                    std::size_t rows_log = 0;
+                    while ((std::size_t(1) << rows_log) < request.rows) {
+                        rows_log++;
+                    }
+
+                    std::vector<commitments::fri_tuning_choice> candidates;
+                    for (std::size_t expand_factor = 1; expand_factor <= request.max_expand_factor; expand_factor++) {
+                        for (std::size_t grinding_bits = 0; grinding_bits <= request.max_grinding_bits;
+                             grinding_bits += 4) {
+                            std::size_t required = request.security_bits > grinding_bits ?
+                                                       request.security_bits - grinding_bits : 0;
+                            std::size_t lambda = std::max<std::size_t>((required + expand_factor - 1) / expand_factor, 1);
+                            if (lambda > request.max_lambda) {
+                                continue;
+                            }
+                            // Final polynomials of 4, 8, 16 and 32 coefficients.
+                            for (std::size_t final_log = 2; final_log <= 5 && final_log <= rows_log; final_log++) {
+                                std::size_t r = rows_log - final_log + 1;
+                                std::vector<std::vector<std::size_t>> step_lists;
+                                for (std::size_t folding_arity : {2, 4, 8, 16}) {
+                                    auto step_list = make_step_list<FRI>(r, folding_arity);
+                                    if (std::find(step_lists.begin(), step_lists.end(), step_list) == step_lists.end()) {
+                                        step_lists.push_back(step_list);
+                                    }
+                                }
+                                for (const auto &step_list : step_lists) {
+                                    auto choice = estimate_fri_costs<FRI>(request, model, lambda, expand_factor,
+                                                                          grinding_bits, r, step_list);
+                                    if (choice.security_bits >= request.security_bits) {
+                                        candidates.push_back(std::move(choice));
+                                    }
+                                }
+                            }
+                        }
+                    }
+
+                    std::vector<commitments::fri_tuning_choice> pareto;
+                    for (const auto &candidate : candidates) {
+                        bool dominated = std::any_of(candidates.begin(), candidates.end(),
+                                                     [&candidate](const commitments::fri_tuning_choice &other) {
+                                                         return other.dominates(candidate);
+                                                     });
+                        if (!dominated) {
+                            pareto.push_back(candidate);
+                        }
+                    }
+                    std::stable_sort(pareto.begin(), pareto.end(),
+                                     [](const commitments::fri_tuning_choice &a,
+                                        const commitments::fri_tuning_choice &b) {
+                                         return a.prover_seconds < b.prover_seconds;
+                                     });
+                    return pareto;
+                }
+
+                /**
+                 * FRI parameters of a choice for polynomials of the given number of rows.
+                 * lambda and grinding_bits are not runtime parameters, FRI must already have been instantiated
+                 * with them, see tune_fri_params.
+                 */
+                template<typename FRI>
+                static typename FRI::params_type make_fri_params(const commitments::fri_tuning_choice &choice,
+                                                                 std::size_t rows) {
+                    std::size_t rows_log = 0;
+                    while ((std::size_t(1) << rows_log) < rows) {
+                        rows_log++;
+                    }
+
+                    typename FRI::params_type params;
+                    params.r = choice.r;
+                    params.max_degree = rows - 1;
+                    params.D = math::calculate_domain_set<typename FRI::field_type>(rows_log + choice.expand_factor,
+                                                                                    choice.r);
+                    params.step_list = choice.step_list;
+                    BOOST_ASSERT(check_step_list<FRI>(params));
+                    return params;
+                }
+            }    // namespace algorithms
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_COMMITMENTS_FRI_PARAMS_TUNER_HPP
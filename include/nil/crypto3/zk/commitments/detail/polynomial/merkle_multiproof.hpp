@@ -0,0 +1,168 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_ZK_COMMITMENTS_DETAIL_MERKLE_MULTIPROOF_HPP
+#define CRYPTO3_ZK_COMMITMENTS_DETAIL_MERKLE_MULTIPROOF_HPP
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+#include <nil/crypto3/container/merkle/tree.hpp>
+#include <nil/crypto3/container/merkle/proof.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace commitments {
+                namespace detail {
+
+                    /**
+                     * @brief Authentication of several leaves of one binary Merkle tree.
+                     * Only the sibling nodes that cannot be computed from the proven leaves are stored,
+                     * level by level from the leaves up, left to right within a level. Paths of different
+                     * leaves share their common upper part, which is stored and hashed once.
+                     */
+                    template<typename MerkleTreeHashType>
+                    struct merkle_multiproof {
+                        using tree_type = containers::merkle_tree<MerkleTreeHashType, 2>;
+                        using merkle_proof_type = containers::merkle_proof<MerkleTreeHashType, 2>;
+                        using digest_type = typename tree_type::value_type;
+                        // (leaf or node position within its level, digest)
+                        using node_type = std::pair<std::size_t, digest_type>;
+
+                        bool operator==(const merkle_multiproof &rhs) const {
+                            return siblings == rhs.siblings;
+                        }
+
+                        bool operator!=(const merkle_multiproof &rhs) const {
+                            return !(rhs == *this);
+                        }
+
+                        /**
+                         * Builds the multi-proof from single-leaf proofs of the same tree.
+                         * Proofs of the same leaf may repeat, the order of the proofs does not matter.
+                         */
+                        static merkle_multiproof from_proofs(const std::vector<merkle_proof_type> &proofs) {
+                            merkle_multiproof result;
+                            if (proofs.empty()) {
+                                return result;
+                            }
+
+                            // (position, index of a proof whose path goes through the position)
+                            std::vector<std::pair<std::size_t, std::size_t>> level(proofs.size());
+                            for (std::size_t i = 0; i < proofs.size(); i++) {
+                                level[i] = {proofs[i].leaf_index(), i};
+                            }
+                            std::sort(level.begin(), level.end());
+                            level.erase(std::unique(level.begin(), level.end(),
+                                                    [](const auto &a, const auto &b) { return a.first == b.first; }),
+                                        level.end());
+
+                            std::size_t depth = proofs.front().path().size();
+                            for (std::size_t l = 0; l < depth; l++) {
+                                std::vector<std::pair<std::size_t, std::size_t>> parents;
+                                for (std::size_t i = 0; i < level.size(); i++) {
+                                    std::size_t position = level[i].first;
+                                    if (position % 2 == 0 && i + 1 < level.size() && level[i + 1].first == position + 1) {
+                                        // Both children are known, the parent is computed.
+                                        i++;
+                                    } else {
+                                        result.siblings.push_back(proofs[level[i].second].path()[l][0].hash());
+                                    }
+                                    parents.emplace_back(position / 2, level[i].second);
+                                }
+                                level = std::move(parents);
+                            }
+                            return result;
+                        }
+
+                        /**
+                         * Checks the leaves against the root of a tree with 2^depth leaves in a single pass:
+                         * every inner node on the union of the paths is hashed once.
+                         * Leaves are given by their positions and leaf hashes, in any order. The same leaf may
+                         * be given several times with the same hash.
+                         */
+                        bool validate(const digest_type &root, std::size_t depth, std::vector<node_type> leaves) const {
+                            if (leaves.empty()) {
+                                return siblings.empty();
+                            }
+
+                            std::sort(leaves.begin(), leaves.end(),
+                                      [](const node_type &a, const node_type &b) { return a.first < b.first; });
+                            std::vector<node_type> level;
+                            level.reserve(leaves.size());
+                            for (const auto &leaf : leaves) {
+                                if ((depth < sizeof(std::size_t) * 8) && (leaf.first >> depth) != 0) {
+                                    return false;
+                                }
+                                if (!level.empty() && level.back().first == leaf.first) {
+                                    if (level.back().second != leaf.second) {
+                                        return false;
+                                    }
+                                    continue;
+                                }
+                                level.push_back(leaf);
+                            }
+
+                            std::size_t next_sibling = 0;
+                            std::array<digest_type, 2> children;
+                            for (std::size_t l = 0; l < depth; l++) {
+                                std::vector<node_type> parents;
+                                parents.reserve(level.size());
+                                for (std::size_t i = 0; i < level.size(); i++) {
+                                    std::size_t position = level[i].first;
+                                    if (position % 2 == 0 && i + 1 < level.size() && level[i + 1].first == position + 1) {
+                                        children[0] = level[i].second;
+                                        children[1] = level[i + 1].second;
+                                        i++;
+                                    } else {
+                                        if (next_sibling == siblings.size()) {
+                                            return false;
+                                        }
+                                        children[position % 2] = level[i].second;
+                                        children[1 - position % 2] = siblings[next_sibling++];
+                                    }
+                                    parents.emplace_back(
+                                        position / 2,
+                                        containers::detail::generate_hash<MerkleTreeHashType>(children.begin(),
+                                                                                              children.end()));
+                                }
+                                level = std::move(parents);
+                            }
+
+                            return next_sibling == siblings.size() && level.size() == 1 && level[0].second == root;
+                        }
+
+                        std::vector<digest_type> siblings;
+                    };
+                }    // namespace detail
+            }        // namespace commitments
+        }            // namespace zk
+    }                // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_COMMITMENTS_DETAIL_MERKLE_MULTIPROOF_HPP
@@ -0,0 +1,249 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_COMMITMENTS_DETAIL_MERKLE_TREE_BUILDER_HPP
+#define CRYPTO3_ZK_COMMITMENTS_DETAIL_MERKLE_TREE_BUILDER_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/align/aligned_allocator.hpp>
+
+#include <nil/crypto3/hash/algorithm/hash.hpp>
+
+#include <nil/crypto3/container/merkle/tree.hpp>
+#include <nil/crypto3/container/merkle/proof.hpp>
+
+#include <nil/crypto3/zk/detail/parallelization.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace commitments {
+                namespace detail {
+
+                    /**
+                     * @brief Contiguous storage for Merkle tree leaves of equal length.
+                     * Leaf i occupies bytes [i * leaf_bytes, (i + 1) * leaf_bytes) of one cache-line aligned buffer.
+                     */
+                    struct flat_leaves_buffer {
+                        using buffer_type = std::vector<std::uint8_t, boost::alignment::aligned_allocator<std::uint8_t, 64>>;
+                        using iterator = buffer_type::iterator;
+                        using const_iterator = buffer_type::const_iterator;
+
+                        flat_leaves_buffer(std::size_t leaves_number, std::size_t leaf_bytes)
+                            : leaf_bytes(leaf_bytes), data(leaves_number * leaf_bytes) {
+                        }
+
+                        std::size_t size() const {
+                            return leaf_bytes == 0 ? 0 : data.size() / leaf_bytes;
+                        }
+
+                        iterator leaf_begin(std::size_t i) {
+                            return data.begin() + i * leaf_bytes;
+                        }
+
+                        const_iterator leaf_begin(std::size_t i) const {
+                            return data.cbegin() + i * leaf_bytes;
+                        }
+
+                        const_iterator leaf_end(std::size_t i) const {
+                            return data.cbegin() + (i + 1) * leaf_bytes;
+                        }
+
+                        std::size_t leaf_bytes;
+                        buffer_type data;
+                    };
+
+                    /**
+                     * @brief Hashes the leaves and the inner levels of a Merkle tree on the prover thread pool.
+                     * Returns the levels from first_level up to the root, lower levels are dropped as soon as
+                     * their parents are hashed.
+                     */
+                    template<typename MerkleTreeHashType, std::size_t Arity>
+                    std::vector<std::vector<typename containers::merkle_tree<MerkleTreeHashType, Arity>::value_type>>
+                        hash_merkle_levels(const flat_leaves_buffer &leaves, std::size_t first_level = 0) {
+                        using digest_type = typename containers::merkle_tree<MerkleTreeHashType, Arity>::value_type;
+
+                        std::vector<std::vector<digest_type>> levels(1);
+                        levels[0].resize(leaves.size());
+                        zk::detail::parallel_for(0, leaves.size(), [&leaves, &levels](std::size_t i) {
+                            levels[0][i] = crypto3::hash<MerkleTreeHashType>(leaves.leaf_begin(i), leaves.leaf_end(i));
+                        }, 64);
+
+                        std::size_t level = 0;
+                        while (levels.back().size() > 1) {
+                            const std::vector<digest_type> &children = levels.back();
+                            std::vector<digest_type> parents(children.size() / Arity);
+                            zk::detail::parallel_for(0, parents.size(), [&children, &parents](std::size_t i) {
+                                auto first = children.begin() + i * Arity;
+                                parents[i] = containers::detail::generate_hash<MerkleTreeHashType>(first, first + Arity);
+                            }, 256);
+                            if (level < first_level) {
+                                levels.back() = std::move(parents);
+                            } else {
+                                levels.push_back(std::move(parents));
+                            }
+                            level++;
+                        }
+                        return levels;
+                    }
+
+                    /**
+                     * @brief Same tree as containers::make_merkle_tree produces for the same leaves.
+                     * Leaves and every inner level are hashed on the prover thread pool,
+                     * the tree is filled once all levels are ready.
+                     */
+                    template<typename MerkleTreeHashType, std::size_t Arity>
+                    containers::merkle_tree<MerkleTreeHashType, Arity>
+                        make_merkle_tree_parallel(const flat_leaves_buffer &leaves) {
+                        using tree_type = containers::merkle_tree<MerkleTreeHashType, Arity>;
+
+                        auto levels = hash_merkle_levels<MerkleTreeHashType, Arity>(leaves);
+                        tree_type tree(leaves.size());
+                        for (auto &level : levels) {
+                            for (auto &digest : level) {
+                                tree.emplace_back(std::move(digest));
+                            }
+                            std::vector<typename tree_type::value_type>().swap(level);
+                        }
+                        return tree;
+                    }
+
+                    /**
+                     * @brief Binary Merkle tree that keeps only the levels at height subtree_height and above.
+                     * Level 0 holds the leaf hashes. A path is completed by rebuilding the subtree of
+                     * 2^subtree_height leaves under the queried leaf from the committed values, so the memory
+                     * is 2^(1 - subtree_height) digests per leaf for 2^subtree_height leaf hashes per path.
+                     * With subtree_height 0 the whole tree is kept.
+                     */
+                    template<typename MerkleTreeHashType>
+                    class merkle_tree_cap {
+                    public:
+                        using tree_type = containers::merkle_tree<MerkleTreeHashType, 2>;
+                        using merkle_proof_type = containers::merkle_proof<MerkleTreeHashType, 2>;
+                        using value_type = typename tree_type::value_type;
+
+                        merkle_tree_cap() : _leaves(0), _leaf_bytes(0), _subtree_height(0) {
+                        }
+
+                        merkle_tree_cap(const flat_leaves_buffer &leaves, std::size_t subtree_height)
+                            : _leaves(leaves.size()), _leaf_bytes(leaves.leaf_bytes), _subtree_height(0) {
+                            BOOST_ASSERT(_leaves > 0 && (_leaves & (_leaves - 1)) == 0);
+                            while ((std::size_t(1) << _subtree_height) < _leaves && _subtree_height < subtree_height) {
+                                _subtree_height++;
+                            }
+                            _levels = hash_merkle_levels<MerkleTreeHashType, 2>(leaves, _subtree_height);
+                        }
+
+                        const value_type &root() const {
+                            return _levels.back()[0];
+                        }
+
+                        std::size_t leaves() const {
+                            return _leaves;
+                        }
+
+                        std::size_t subtree_height() const {
+                            return _subtree_height;
+                        }
+
+                        /**
+                         * Same proof as containers::merkle_proof of the full tree gives.
+                         * write_leaf(i, iter) writes the data of leaf i, as it was committed, to iter. It is
+                         * not called with subtree_height 0 unless assertions are enabled.
+                         */
+                        template<typename LeafWriter>
+                        merkle_proof_type proof(std::size_t leaf_index, LeafWriter write_leaf) const {
+                            BOOST_ASSERT(leaf_index < _leaves);
+
+                            std::size_t depth = 0;
+                            while ((std::size_t(1) << depth) < _leaves) {
+                                depth++;
+                            }
+                            typename merkle_proof_type::path_type path(depth);
+                            auto set_sibling = [&path](std::size_t level, std::size_t position, const value_type &hash) {
+                                path[level][0] = typename merkle_proof_type::path_element_type(hash, position % 2);
+                            };
+
+                            if (_subtree_height == 0) {
+                                // The whole tree is kept, the leaf is only written to check it.
+#ifndef NDEBUG
+                                flat_leaves_buffer leaf(1, _leaf_bytes);
+                                write_leaf(leaf_index, leaf.leaf_begin(0));
+                                const flat_leaves_buffer &written_leaf = leaf;
+                                BOOST_ASSERT(crypto3::hash<MerkleTreeHashType>(written_leaf.leaf_begin(0),
+                                                                               written_leaf.leaf_end(0)) ==
+                                             _levels[0][leaf_index]);
+#endif
+                            } else {
+                                std::size_t subtree_size = std::size_t(1) << _subtree_height;
+                                std::size_t subtree_begin = leaf_index - leaf_index % subtree_size;
+                                flat_leaves_buffer subtree_leaves(subtree_size, _leaf_bytes);
+                                for (std::size_t i = 0; i < subtree_size; i++) {
+                                    write_leaf(subtree_begin + i, subtree_leaves.leaf_begin(i));
+                                }
+                                const flat_leaves_buffer &written_leaves = subtree_leaves;
+                                std::vector<value_type> level(subtree_size);
+                                for (std::size_t i = 0; i < subtree_size; i++) {
+                                    level[i] = crypto3::hash<MerkleTreeHashType>(written_leaves.leaf_begin(i),
+                                                                                written_leaves.leaf_end(i));
+                                }
+
+                                std::size_t position = leaf_index - subtree_begin;
+                                for (std::size_t l = 0; l < _subtree_height; l++) {
+                                    set_sibling(l, position ^ 1, level[position ^ 1]);
+                                    std::vector<value_type> parents(level.size() / 2);
+                                    for (std::size_t i = 0; i < parents.size(); i++) {
+                                        parents[i] = containers::detail::generate_hash<MerkleTreeHashType>(
+                                            level.begin() + 2 * i, level.begin() + 2 * i + 2);
+                                    }
+                                    level = std::move(parents);
+                                    position /= 2;
+                                }
+                                BOOST_ASSERT(level.size() == 1 &&
+                                             level[0] == _levels[0][leaf_index >> _subtree_height]);
+                            }
+
+                            for (std::size_t l = _subtree_height; l < depth; l++) {
+                                std::size_t sibling = (leaf_index >> l) ^ 1;
+                                set_sibling(l, sibling, _levels[l - _subtree_height][sibling]);
+                            }
+                            return merkle_proof_type(leaf_index, root(), path);
+                        }
+
+                    private:
+                        std::size_t _leaves;
+                        std::size_t _leaf_bytes;
+                        std::size_t _subtree_height;
+                        std::vector<std::vector<value_type>> _levels;
+                    };
+                }    // namespace detail
+            }        // namespace commitments
+        }            // namespace zk
+    }                // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_COMMITMENTS_DETAIL_MERKLE_TREE_BUILDER_HPP
@@ -25,21 +25,128 @@
 #ifndef PROOF_OF_WORK_HPP
 #define PROOF_OF_WORK_HPP
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
 #include <boost/property_tree/ptree.hpp>
 
 #include <nil/crypto3/marshalling/algebra/types/field_element.hpp>
+#include <nil/crypto3/zk/detail/parallelization.hpp>
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 
 namespace nil {
     namespace crypto3 {
         namespace zk {
             namespace commitments {
-                template<typename TranscriptHashType, typename OutType = std::uint32_t, std::uint32_t mask=0xFFFF0000>
+                namespace detail {
+                    /**
+                     * @brief Nonce search for proof_of_work.
+                     * A nonce is absorbed by the transcript as sizeof(OutType) big-endian bytes and is valid when
+                     * the following int_challenge has none of the mask bits set. The transcript state is absorbed
+                     * into the hash once, every attempt finishes a copy of that hash state.
+                     * Nonces are tried from the seed upwards in batches split across the thread pool, the smallest
+                     * valid one of a batch is taken, so the result depends on the seed only.
+                     */
+                    template<typename TranscriptHashType, typename OutType>
+                    struct grinding_engine {
+                        using transcript_hash_type = TranscriptHashType;
+                        using transcript_type = transcript::fiat_shamir_heuristic_sequential<transcript_hash_type>;
+                        using output_type = OutType;
+                        using nonce_bytes_type = std::array<std::uint8_t, sizeof(OutType)>;
+                        using accumulator_type = accumulator_set<transcript_hash_type>;
+
+                        static inline nonce_bytes_type nonce_bytes(output_type nonce) {
+                            nonce_bytes_type bytes;
+                            for (std::size_t i = bytes.size(); i > 0; i--) {
+                                bytes[i - 1] = std::uint8_t(nonce & 0xFF);
+                                nonce >>= 8;
+                            }
+                            return bytes;
+                        }
+
+                        // The challenge transcript(nonce_bytes(nonce)) followed by int_challenge gives,
+                        // prefix holds the absorbed transcript state.
+                        static inline output_type challenge(const accumulator_type &prefix, output_type nonce) {
+                            accumulator_type acc = prefix;
+                            nonce_bytes_type bytes = nonce_bytes(nonce);
+                            typename transcript_hash_type::digest_type state =
+                                accumulators::extract::hash<transcript_hash_type>(
+                                    hash<transcript_hash_type>(bytes, acc));
+                            state = hash<transcript_hash_type>(state);
+                            nil::marshalling::status_type status;
+                            output_type result = nil::marshalling::pack(state, status);
+                            return result;
+                        }
+
+                        static inline output_type generate(transcript_type &transcript, output_type mask,
+                                                           output_type seed, std::size_t batch_size = 1 << 16) {
+                            auto prefix_convertible = hash<transcript_hash_type>(transcript.get_state());
+                            const accumulator_type &prefix = static_cast<accumulator_type &>(prefix_convertible);
+
+                            output_type proof_of_work = seed;
+                            for (output_type batch_begin = seed;; batch_begin += output_type(batch_size)) {
+                                std::atomic<std::size_t> found(batch_size);
+                                zk::detail::parallel_for_chunks(0, batch_size, [&](std::size_t begin, std::size_t end) {
+                                    // Offsets above an already found one do not matter.
+                                    for (std::size_t i = begin; i < end && i < found.load(); i++) {
+                                        if ((challenge(prefix, output_type(batch_begin + i)) & mask) == 0) {
+                                            std::size_t current = found.load();
+                                            while (i < current && !found.compare_exchange_weak(current, i)) {
+                                            }
+                                            break;
+                                        }
+                                    }
+                                }, 1024);
+                                if (found.load() < batch_size) {
+                                    proof_of_work = output_type(batch_begin + found.load());
+                                    break;
+                                }
+                            }
+
+                            transcript(nonce_bytes(proof_of_work));
+                            transcript.template int_challenge<output_type>();
+                            return proof_of_work;
+                        }
+
+                        static inline bool verify(transcript_type &transcript, output_type proof_of_work,
+                                                  output_type mask) {
+                            transcript(nonce_bytes(proof_of_work));
+                            output_type result = transcript.template int_challenge<output_type>();
+                            return ((result & mask) == 0);
+                        }
+                    };
+
+                    // Mask of the GrindingBits most significant bits of OutType.
+                    template<typename OutType>
+                    constexpr OutType grinding_mask(std::size_t grinding_bits) {
+                        return grinding_bits == 0 ?
+                                   OutType(0) :
+                                   OutType(std::numeric_limits<OutType>::max()
+                                           << (std::numeric_limits<OutType>::digits - grinding_bits));
+                    }
+
+                    // Challenge bits a mask requires to be zero.
+                    template<typename OutType>
+                    constexpr std::size_t grinding_mask_bits(OutType mask) {
+                        return mask == 0 ? 0 : std::size_t(mask & 1) + grinding_mask_bits<OutType>(mask >> 1);
+                    }
+                }    // namespace detail
+
+                /**
+                 * Grinding with a fixed mask of challenge bits that must be zero.
+                 * generate is deterministic: the same transcript and seed give the same nonce.
+                 */
+                template<typename TranscriptHashType, typename OutType = std::uint32_t, OutType mask = 0xFFFF0000>
                 class proof_of_work {
                 public:
                     using transcript_hash_type = TranscriptHashType;
                     using transcript_type = transcript::fiat_shamir_heuristic_sequential<transcript_hash_type>;
                     using output_type = OutType;
+                    using engine_type = detail::grinding_engine<transcript_hash_type, output_type>;
+
+                    constexpr static const std::size_t grinding_bits = detail::grinding_mask_bits<OutType>(mask);
 
                     static inline boost::property_tree::ptree get_params(){
                         boost::property_tree::ptree params;
@@ -47,41 +154,22 @@ namespace nil {
                         return params;
                     }
 
-                    static inline OutType generate(transcript_type &transcript){
-                        output_type proof_of_work = std::rand();
-                        output_type result;
-                        std::vector<std::uint8_t> bytes(4);
-
-                        while( true ){
-                            transcript_type tmp_transcript = transcript;
-                            bytes[0] = std::uint8_t((proof_of_work&0xFF000000)>>24);
-                            bytes[1] = std::uint8_t((proof_of_work&0x00FF0000)>>16);
-                            bytes[2] = std::uint8_t((proof_of_work&0x0000FF00)>>8);
-                            bytes[3] = std::uint8_t(proof_of_work&0x000000FF);
-                            tmp_transcript(bytes);
-                            result = tmp_transcript.template int_challenge<output_type>();
-                            if((result & mask) == 0) break;
-                            proof_of_work++;
-                        }
-                        transcript(bytes);
-                        result = transcript.template int_challenge<output_type>();
-                        return proof_of_work;
+                    static inline OutType generate(transcript_type &transcript, output_type seed = 0){
+                        return engine_type::generate(transcript, mask, seed);
                     }
 
                     static inline bool verify(transcript_type &transcript, output_type proof_of_work){
-                        std::vector<std::uint8_t> bytes(4);
-                        bytes[0] = std::uint8_t((proof_of_work&0xFF000000)>>24);
-                        bytes[1] = std::uint8_t((proof_of_work&0x00FF0000)>>16);
-                        bytes[2] = std::uint8_t((proof_of_work&0x0000FF00)>>8);
-                        bytes[3] = std::uint8_t(proof_of_work&0x000000FF);
-                        transcript(bytes);
-                        output_type result = transcript.template int_challenge<output_type>();
-                        return ((result & mask) == 0);
+                        return engine_type::verify(transcript, proof_of_work, mask);
                     }
                 };
+
+                // Grinding that requires the GrindingBits most significant bits of the challenge to be zero.
+                template<typename TranscriptHashType, std::size_t GrindingBits, typename OutType = std::uint64_t>
+                using proof_of_work_bits =
+                    proof_of_work<TranscriptHashType, OutType, detail::grinding_mask<OutType>(GrindingBits)>;
             }
         }
     }
 }
 
-#endif
\ No newline at end of file
+#endif
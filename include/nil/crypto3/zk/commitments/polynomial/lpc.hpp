@@ -30,12 +30,16 @@
 #ifndef CRYPTO3_ZK_LIST_POLYNOMIAL_COMMITMENT_SCHEME_HPP
 #define CRYPTO3_ZK_LIST_POLYNOMIAL_COMMITMENT_SCHEME_HPP
 
+#include <algorithm>
+
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 #include <nil/crypto3/math/polynomial/lagrange_interpolation.hpp>
 
 #include <nil/crypto3/container/merkle/tree.hpp>
 #include <nil/crypto3/container/merkle/proof.hpp>
 
+#include <nil/crypto3/zk/detail/batch_inversion.hpp>
+#include <nil/crypto3/zk/detail/parallelization.hpp>
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 #include <nil/crypto3/zk/commitments/batched_commitment.hpp>
 #include <nil/crypto3/zk/commitments/detail/polynomial/basic_fri.hpp>
@@ -60,6 +64,7 @@ namespace nil {
                     using fri_type = typename LPCScheme::fri_type;
                     using basic_fri = typename LPCScheme::fri_type;
                     using proof_type = typename LPCScheme::proof_type;
+                    using compressed_proof_type = typename LPCScheme::compressed_proof_type;
                     using transcript_type = typename LPCScheme::transcript_type;
                     using transcript_hash_type = typename LPCScheme::transcript_hash_type;
                     using poly_type = PolynomialType;
@@ -68,7 +73,8 @@ namespace nil {
                     using preprocessed_data_type = std::map<std::size_t, std::vector<value_type>>;
 
                 private:
-                    std::map<std::size_t, precommitment_type> _trees;
+                    // Only the upper levels are kept, see params_type::merkle_subtree_height.
+                    std::map<std::size_t, typename fri_type::capped_precommitment_type> _trees;
                     typename fri_type::params_type _fri_params;
                     value_type _etha;
                     std::map<std::size_t, bool> _batch_fixed;
@@ -100,8 +106,9 @@ namespace nil {
 
                     commitment_type commit(std::size_t index) {
                         this->state_commited(index);
-                        _trees[index] = nil::crypto3::zk::algorithms::precommit<fri_type>(
-                            this->_polys[index], _fri_params.D[0], _fri_params.step_list.front());
+                        _trees[index] = nil::crypto3::zk::algorithms::precommit_capped<fri_type>(
+                            this->_polys[index].begin(), this->_polys[index].end(), _fri_params.D[0],
+                            _fri_params.step_list.front(), _fri_params.merkle_subtree_height);
                         return _trees[index].root();
                     }
 
@@ -130,84 +137,185 @@ namespace nil {
                         auto theta = transcript.template challenge<field_type>();
                         poly_type combined_Q;
 
-                        if constexpr (std::is_same<math::polynomial_dfs<value_type>, PolynomialType>::value
-                        ) {
-                            bool first = true;
-                            // prepare U and V
-                            for(auto const &it: this->_polys){
-                                auto b_ind = it.first;
-                                BOOST_ASSERT(this->_points[b_ind].size() == this->_polys[b_ind].size());
-                                BOOST_ASSERT(this->_points[b_ind].size() == this->_z.get_batch_size(b_ind));
-
-                                for( std::size_t poly_ind = 0; poly_ind < this->_polys[b_ind].size(); poly_ind++) {
-                                    // All evaluation points are filled successfully.
-                                    auto& points = this->_points[b_ind][poly_ind];
-                                    BOOST_ASSERT(points.size() == this->_z.get_poly_points_number(b_ind, poly_ind));
+                        // Flat list of (batch, polynomial) pairs in the order they are combined with theta.
+                        std::vector<std::pair<std::size_t, std::size_t>> poly_ids;
+                        for(auto const &it: this->_polys){
+                            auto b_ind = it.first;
+                            BOOST_ASSERT(this->_points[b_ind].size() == this->_polys[b_ind].size());
+                            BOOST_ASSERT(this->_points[b_ind].size() == this->_z.get_batch_size(b_ind));
+
+                            for( std::size_t poly_ind = 0; poly_ind < this->_polys[b_ind].size(); poly_ind++) {
+                                // All evaluation points are filled successfully.
+                                BOOST_ASSERT(this->_points[b_ind][poly_ind].size() ==
+                                             this->_z.get_poly_points_number(b_ind, poly_ind));
+                                poly_ids.emplace_back(b_ind, poly_ind);
+                            }
+                        }
 
-                                    std::vector<math::polynomial<value_type>> V_multipliers = this->get_V_multipliers(points);
+                        // Polynomial number id is combined with theta^(N - 1 - id), N = poly_ids.size().
+                        std::vector<value_type> theta_powers(poly_ids.size());
+                        if (!poly_ids.empty()) {
+                            theta_powers.back() = value_type::one();
+                            for (std::size_t id = poly_ids.size() - 1; id > 0; id--) {
+                                theta_powers[id - 1] = theta_powers[id] * theta;
+                            }
+                        }
 
-                                    math::polynomial<value_type> U = this->get_U(b_ind, poly_ind);
+                        // (g - U) / V is linear in g and U for a fixed V, so the polynomials opened at the same
+                        // point set are combined with theta first and divided once.
+                        auto unique_points = this->get_unique_points_list();
+                        auto eval_map = this->get_eval_map(unique_points);
 
-                                    math::polynomial<value_type> g_normal(this->_polys[b_ind][poly_ind].coefficients());
-                                    math::polynomial<value_type> Q = g_normal - U;
+                        if constexpr (std::is_same<math::polynomial_dfs<value_type>, PolynomialType>::value
+                        ) {
+                            // Polynomials of the same size are also combined before the extension to D[0].
+                            std::vector<std::map<std::size_t, std::vector<std::size_t>>> groups(unique_points.size());
+                            for (std::size_t id = 0; id < poly_ids.size(); id++) {
+                                auto [b_ind, poly_ind] = poly_ids[id];
+                                groups[eval_map.at(b_ind)[poly_ind]][this->_polys.at(b_ind)[poly_ind].size()].push_back(id);
+                            }
 
-                                    for (const auto& V_mult: V_multipliers) {
+                            const std::size_t D0_size = _fri_params.D[0]->size();
+                            std::vector<value_type> D0_elements = get_D0_elements();
+                            std::vector<value_type> combined_Q_values(D0_size, value_type::zero());
+                            std::size_t combined_Q_degree = 0;
+                            for (std::size_t point_index = 0; point_index < unique_points.size(); point_index++) {
+                                if (groups[point_index].empty()) {
+                                    continue;
+                                }
+                                const auto &points = unique_points[point_index];
+
+                                // V vanishes on D[0] at a point of D[0], such a group is divided exactly in
+                                // coefficient form instead.
+                                bool point_in_D0 = std::any_of(points.begin(), points.end(),
+                                    [D0_size](const value_type &point) {
+                                        return point.pow(D0_size) == value_type::one();
+                                    });
+                                if (point_in_D0) {
+                                    math::polynomial<value_type> Q = {value_type::zero()};
+                                    for (auto const &[size, ids] : groups[point_index]) {
+                                        for (std::size_t id : ids) {
+                                            auto [b_ind, poly_ind] = poly_ids[id];
+                                            const auto &poly = this->_polys.at(b_ind)[poly_ind];
+                                            math::polynomial<value_type> g_normal(poly.coefficients());
+                                            math::polynomial<value_type> Q_id = g_normal - this->get_U(b_ind, poly_ind);
+                                            Q_id *= theta_powers[id];
+                                            Q += Q_id;
+
+                                            std::size_t Q_degree = poly.degree() >= points.size() ?
+                                                                   poly.degree() - points.size() : 0;
+                                            combined_Q_degree = std::max(combined_Q_degree, Q_degree);
+                                        }
+                                    }
+                                    for (const auto& V_mult: this->get_V_multipliers(points)) {
                                         Q /= V_mult;
                                     }
 
-                                    math::polynomial_dfs<value_type> Q_dfs(0, _fri_params.D[0]->size());
+                                    math::polynomial_dfs<value_type> Q_dfs(0, D0_size);
                                     Q_dfs.from_coefficients(Q);
+                                    zk::detail::parallel_for(0, D0_size, [&combined_Q_values, &Q_dfs](std::size_t i) {
+                                        combined_Q_values[i] += Q_dfs[i];
+                                    }, 4096);
+                                    continue;
+                                }
+
+                                math::polynomial<value_type> U = {value_type::zero()};
+                                math::polynomial_dfs<value_type> g_dfs;
+                                for (auto const &[size, ids] : groups[point_index]) {
+                                    std::vector<const math::polynomial_dfs<value_type> *> polys;
+                                    std::size_t degree = 0;
+                                    for (std::size_t id : ids) {
+                                        auto [b_ind, poly_ind] = poly_ids[id];
+                                        polys.push_back(&this->_polys.at(b_ind)[poly_ind]);
+                                        degree = std::max(degree, polys.back()->degree());
+
+                                        math::polynomial<value_type> U_id = this->get_U(b_ind, poly_ind);
+                                        U_id *= theta_powers[id];
+                                        U += U_id;
+
+                                        std::size_t Q_degree = polys.back()->degree() >= points.size() ?
+                                                               polys.back()->degree() - points.size() : 0;
+                                        combined_Q_degree = std::max(combined_Q_degree, Q_degree);
+                                    }
 
-                                    if (first) {
-                                        first = false;
-                                        combined_Q = Q_dfs;
+                                    math::polynomial_dfs<value_type> g_size(degree, size);
+                                    zk::detail::parallel_for_chunks(0, size,
+                                        [&g_size, &polys, &ids, &theta_powers](std::size_t begin, std::size_t end) {
+                                            for (std::size_t i = begin; i < end; i++) {
+                                                value_type sum = value_type::zero();
+                                                for (std::size_t k = 0; k < polys.size(); k++) {
+                                                    sum += theta_powers[ids[k]] * (*polys[k])[i];
+                                                }
+                                                g_size[i] = sum;
+                                            }
+                                        }, 1024);
+                                    g_size.resize(D0_size);
+
+                                    if (g_dfs.size() == 0) {
+                                        g_dfs = std::move(g_size);
                                     } else {
-                                        combined_Q *= theta;
-                                        combined_Q += Q_dfs;
+                                        zk::detail::parallel_for(0, D0_size, [&g_dfs, &g_size](std::size_t i) {
+                                            g_dfs[i] += g_size[i];
+                                        }, 4096);
                                     }
                                 }
-                            }
-                        } else {
-                            bool first = true;
-
-                            // prepare U and V
-                            for(auto const &it: this->_polys) {
-                                auto b_ind = it.first;
-
-                                BOOST_ASSERT(this->_points[b_ind].size() == this->_polys[b_ind].size());
-                                BOOST_ASSERT(this->_points[b_ind].size() == this->_z.get_batch_size(b_ind));
 
-                                for(std::size_t poly_ind = 0; poly_ind < this->_polys[b_ind].size(); poly_ind++) {
-                                    // All evaluation points are filled successfully.
-                                    const auto& points = this->_points[b_ind][poly_ind];
-                                    BOOST_ASSERT(points.size() == this->_z.get_poly_points_number(b_ind, poly_ind));
-
-                                    std::vector<math::polynomial<value_type>> V_multipliers = this->get_V_multipliers(points);
-                                    math::polynomial<value_type> U =  this->get_U(b_ind, poly_ind);
-
-                                    math::polynomial<value_type> g_normal = this->_polys[b_ind][poly_ind];
-                                    math::polynomial<value_type> Q = g_normal - U;
-
-                                    for (const auto& V_mult: V_multipliers) {
-                                        Q /= V_mult;
+                                std::vector<value_type> V_inv = get_V_inversed_on_D0(points, D0_elements);
+                                zk::detail::parallel_for_chunks(0, D0_size, [&](std::size_t begin, std::size_t end) {
+                                    for (std::size_t i = begin; i < end; i++) {
+                                        combined_Q_values[i] += (g_dfs[i] - U.evaluate(D0_elements[i])) * V_inv[i];
                                     }
+                                }, 1024);
+                            }
 
-                                    if (first) {
-                                        first = false;
-                                        combined_Q = Q;
-                                    } else {
-                                        combined_Q *= theta;
-                                        combined_Q += Q;
-                                    }
+                            combined_Q = math::polynomial_dfs<value_type>(combined_Q_degree, D0_size);
+                            std::copy(combined_Q_values.begin(), combined_Q_values.end(), combined_Q.begin());
+                        } else {
+                            std::vector<math::polynomial<value_type>> group_Q(unique_points.size());
+                            std::vector<bool> group_used(unique_points.size(), false);
+                            for (std::size_t id = 0; id < poly_ids.size(); id++) {
+                                auto [b_ind, poly_ind] = poly_ids[id];
+                                math::polynomial<value_type> U = this->get_U(b_ind, poly_ind);
+                                math::polynomial<value_type> g_normal = this->_polys[b_ind][poly_ind];
+                                math::polynomial<value_type> Q = g_normal - U;
+                                Q *= theta_powers[id];
+
+                                std::size_t point_index = eval_map.at(b_ind)[poly_ind];
+                                if (group_used[point_index]) {
+                                    group_Q[point_index] += Q;
+                                } else {
+                                    group_used[point_index] = true;
+                                    group_Q[point_index] = Q;
+                                }
+                            }
+
+                            bool first = true;
+                            for (std::size_t point_index = 0; point_index < group_Q.size(); point_index++) {
+                                if (!group_used[point_index]) {
+                                    continue;
+                                }
+                                math::polynomial<value_type> &Q = group_Q[point_index];
+                                for (const auto& V_mult: this->get_V_multipliers(unique_points[point_index])) {
+                                    Q /= V_mult;
+                                }
+                                if (first) {
+                                    first = false;
+                                    combined_Q = Q;
+                                } else {
+                                    combined_Q += Q;
                                 }
                             }
                         }
 
-                        precommitment_type combined_Q_precommitment = nil::crypto3::zk::algorithms::precommit<fri_type>(
-                            combined_Q,
-                            _fri_params.D[0],
-                            _fri_params.step_list.front()
-                        );
+                        if constexpr (std::is_same<math::polynomial_dfs<value_type>, PolynomialType>::value) {
+                            if (combined_Q.size() != _fri_params.D[0]->size()) {
+                                combined_Q.resize(_fri_params.D[0]->size());
+                            }
+                        }
+                        typename fri_type::capped_precommitment_type combined_Q_precommitment =
+                            nil::crypto3::zk::algorithms::precommit_capped<fri_type>(
+                                &combined_Q, &combined_Q + 1, _fri_params.D[0], _fri_params.step_list.front(),
+                                _fri_params.merkle_subtree_height);
 
                         typename fri_type::proof_type fri_proof = nil::crypto3::zk::algorithms::proof_eval<
                             fri_type, poly_type
@@ -226,6 +334,25 @@ namespace nil {
                         const proof_type &proof,
                         const std::map<std::size_t, commitment_type> &commitments,
                         transcript_type &transcript
+                    ) {
+                        return verify_eval_impl(proof, commitments, transcript);
+                    }
+
+                    // Same check for a proof with compressed Merkle multi-proofs, see LPCScheme::compress_proof.
+                    bool verify_eval(
+                        const compressed_proof_type &proof,
+                        const std::map<std::size_t, commitment_type> &commitments,
+                        transcript_type &transcript
+                    ) {
+                        return verify_eval_impl(proof, commitments, transcript);
+                    }
+
+                private:
+                    template<typename ProofType>
+                    bool verify_eval_impl(
+                        const ProofType &proof,
+                        const std::map<std::size_t, commitment_type> &commitments,
+                        transcript_type &transcript
                     ) {
                         for (auto const&[b_ind, fixed]: _batch_fixed) {
                             if(!fixed) continue;
@@ -237,7 +364,6 @@ namespace nil {
                             }
                         }
 
-                        this->_z = proof.z;
                         for (auto const &it: commitments) {
                             transcript(commitments.at(it.first));
                         }
@@ -267,7 +393,7 @@ namespace nil {
                                 for (std::size_t i = 0; i < proof.z.get_batch_size(k); i++) {
                                     combined_U[point_index] *= theta;
                                     if (eval_map[k][i] == point_index) {
-                                        combined_U[point_index] += this->get_U(k, i);
+                                        combined_U[point_index] += this->get_U(proof.z, k, i);
                                     }
                                 }
                             }
@@ -289,6 +415,41 @@ namespace nil {
                         return true;
                     }
 
+                public:
+                    // Elements of D[0] in their natural order.
+                    std::vector<value_type> get_D0_elements() const {
+                        const auto &D0 = _fri_params.D[0];
+                        std::vector<value_type> elements(D0->size());
+                        value_type omega = D0->get_domain_element(1);
+                        zk::detail::parallel_for_chunks(0, elements.size(),
+                            [&elements, &omega](std::size_t begin, std::size_t end) {
+                                value_type acc = omega.pow(begin);
+                                for (std::size_t i = begin; i < end; i++) {
+                                    elements[i] = acc;
+                                    acc *= omega;
+                                }
+                            }, 1024);
+                        return elements;
+                    }
+
+                    // 1 / V(x) for all x in D[0]. The points must be out of D[0], proof_eval divides the groups
+                    // with a point in D[0] in coefficient form.
+                    static std::vector<value_type> get_V_inversed_on_D0(
+                            const std::vector<value_type> &points, const std::vector<value_type> &D0_elements) {
+                        std::vector<value_type> V_inv(D0_elements.size());
+                        zk::detail::parallel_for_chunks(0, V_inv.size(),
+                            [&V_inv, &points, &D0_elements](std::size_t begin, std::size_t end) {
+                                for (std::size_t i = begin; i < end; i++) {
+                                    V_inv[i] = value_type::one();
+                                    for (const auto &point: points) {
+                                        V_inv[i] *= D0_elements[i] - point;
+                                    }
+                                }
+                                zk::detail::batch_inversion_serial(V_inv.begin() + begin, V_inv.begin() + end);
+                            }, 4096);
+                        return V_inv;
+                    }
+
                     const typename fri_type::params_type &get_fri_params() const {
                         return _fri_params;
                     }
@@ -408,6 +569,25 @@ namespace nil {
                         eval_storage_type z;
                         typename basic_fri::proof_type fri_proof;
                     };
+
+                    // proof_type with the FRI Merkle paths merged into one multi-proof per tree.
+                    struct compressed_proof_type {
+                        bool operator==(const compressed_proof_type &rhs) const {
+                            return fri_proof == rhs.fri_proof && z == rhs.z;
+                        }
+
+                        bool operator!=(const compressed_proof_type &rhs) const {
+                            return !(rhs == *this);
+                        }
+
+                        eval_storage_type z;
+                        typename basic_fri::compressed_proof_type fri_proof;
+                    };
+
+                    static compressed_proof_type compress_proof(const proof_type &proof) {
+                        return compressed_proof_type(
+                            {proof.z, nil::crypto3::zk::algorithms::compress_proof<basic_fri>(proof.fri_proof)});
+                    }
                 };
 
                 template<typename FieldType, typename LPCParams>
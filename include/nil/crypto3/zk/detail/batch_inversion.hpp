@@ -0,0 +1,87 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_DETAIL_BATCH_INVERSION_HPP
+#define CRYPTO3_ZK_DETAIL_BATCH_INVERSION_HPP
+
+#include <iterator>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <nil/crypto3/zk/detail/parallelization.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace detail {
+
+                /**
+                 * Inverts all elements of [begin, end) in place with Montgomery's trick:
+                 * one field inversion and 3 * (n - 1) multiplications. All elements must be non-zero.
+                 */
+                template<typename Iterator>
+                void batch_inversion_serial(Iterator begin, Iterator end) {
+                    using value_type = typename std::iterator_traits<Iterator>::value_type;
+
+                    if (begin == end) {
+                        return;
+                    }
+
+                    std::vector<value_type> prefix;
+                    prefix.reserve(std::distance(begin, end));
+                    value_type acc = value_type::one();
+                    for (Iterator it = begin; it != end; ++it) {
+                        BOOST_ASSERT(*it != value_type::zero());
+                        prefix.push_back(acc);
+                        acc *= *it;
+                    }
+
+                    acc = acc.inversed();
+                    std::size_t i = prefix.size();
+                    for (Iterator it = end; it != begin;) {
+                        --it;
+                        --i;
+                        value_type inversed = acc * prefix[i];
+                        acc *= *it;
+                        *it = inversed;
+                    }
+                }
+
+                /**
+                 * Inverts all elements of the vector in place. The vector is split into independent blocks,
+                 * each block is inverted with one field inversion on the thread pool.
+                 */
+                template<typename ValueType>
+                void batch_inversion(std::vector<ValueType> &values, std::size_t grain_size = 4096) {
+                    parallel_for_chunks(0, values.size(), [&values](std::size_t begin, std::size_t end) {
+                        batch_inversion_serial(values.begin() + begin, values.begin() + end);
+                    }, grain_size);
+                }
+            }    // namespace detail
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_DETAIL_BATCH_INVERSION_HPP
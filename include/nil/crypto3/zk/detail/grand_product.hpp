@@ -0,0 +1,108 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_ZK_DETAIL_GRAND_PRODUCT_HPP
+#define CRYPTO3_ZK_DETAIL_GRAND_PRODUCT_HPP
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <nil/crypto3/zk/detail/batch_inversion.hpp>
+#include <nil/crypto3/zk/detail/parallelization.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace detail {
+
+                /**
+                 * Fills result[0, n) with the running product of the ratios, n = numerators.size():
+                 * result[0] = 1, result[j] = result[j - 1] * numerators[j] / denominators[j].
+                 * Elements with index 0 are not used, the denominators are replaced by their inverses.
+                 *
+                 * The range is cut into blocks that are inverted and scanned independently on the pool,
+                 * then every block is multiplied by the product of the blocks before it.
+                 * The field arithmetic is exact, so the result does not depend on the number of threads.
+                 */
+                template<typename ValueType, typename ResultType>
+                void grand_product(const std::vector<ValueType> &numerators, std::vector<ValueType> &denominators,
+                                   ResultType &result, std::size_t grain_size = 4096,
+                                   thread_pool &pool = thread_pool::instance()) {
+                    BOOST_ASSERT(numerators.size() == denominators.size());
+                    BOOST_ASSERT(result.size() >= numerators.size());
+
+                    std::size_t size = numerators.size();
+                    if (size == 0) {
+                        return;
+                    }
+                    result[0] = ValueType::one();
+                    if (size == 1) {
+                        return;
+                    }
+
+                    std::size_t range = size - 1;
+                    std::size_t block_size =
+                        std::max<std::size_t>(std::max<std::size_t>(grain_size, 1),
+                                              (range + pool.size() * 4 - 1) / (pool.size() * 4));
+                    std::size_t blocks_num = (range + block_size - 1) / block_size;
+                    auto block_begin = [block_size](std::size_t block) { return 1 + block * block_size; };
+                    auto block_end = [block_size, size](std::size_t block) {
+                        return std::min(size, 1 + (block + 1) * block_size);
+                    };
+
+                    // Local scans, every block starts from one.
+                    parallel_for(0, blocks_num, [&](std::size_t block) {
+                        std::size_t begin = block_begin(block);
+                        std::size_t end = block_end(block);
+                        batch_inversion_serial(denominators.begin() + begin, denominators.begin() + end);
+
+                        ValueType acc = ValueType::one();
+                        for (std::size_t j = begin; j < end; j++) {
+                            acc *= numerators[j];
+                            acc *= denominators[j];
+                            result[j] = acc;
+                        }
+                    }, 1, pool);
+
+                    // Products of all the blocks before each block.
+                    std::vector<ValueType> block_prefix(blocks_num, ValueType::one());
+                    for (std::size_t block = 1; block < blocks_num; block++) {
+                        block_prefix[block] = block_prefix[block - 1] * result[block_end(block - 1) - 1];
+                    }
+
+                    parallel_for(1, blocks_num, [&](std::size_t block) {
+                        for (std::size_t j = block_begin(block); j < block_end(block); j++) {
+                            result[j] *= block_prefix[block];
+                        }
+                    }, 1, pool);
+                }
+            }    // namespace detail
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_DETAIL_GRAND_PRODUCT_HPP
@@ -0,0 +1,142 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_DETAIL_PARALLELIZATION_HPP
+#define CRYPTO3_ZK_DETAIL_PARALLELIZATION_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <nil/crypto3/zk/detail/thread_pool.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace detail {
+
+                /**
+                 * @brief Splits [begin, end) into chunks of at least grain_size elements and calls
+                 * func(chunk_begin, chunk_end) for each of them on the pool. The calling thread processes chunks
+                 * too and returns when all of them are done. The first exception thrown by func is rethrown.
+                 *
+                 * Chunks have to write into disjoint memory, so that the result does not depend on
+                 * the number of threads.
+                 */
+                template<typename FuncType>
+                void parallel_for_chunks(std::size_t begin, std::size_t end, FuncType &&func,
+                                         std::size_t grain_size = 1,
+                                         thread_pool &pool = thread_pool::instance()) {
+                    if (begin >= end) {
+                        return;
+                    }
+
+                    std::size_t range = end - begin;
+                    grain_size = std::max<std::size_t>(grain_size, 1);
+                    // A few chunks per thread to level out the unequal ones.
+                    std::size_t chunks_num = std::min((range + grain_size - 1) / grain_size, pool.size() * 4);
+                    if (chunks_num <= 1 || pool.size() == 1) {
+                        func(begin, end);
+                        return;
+                    }
+                    std::size_t chunk_size = (range + chunks_num - 1) / chunks_num;
+                    chunks_num = (range + chunk_size - 1) / chunk_size;
+
+                    struct section_state {
+                        std::atomic<std::size_t> next_chunk {0};
+                        std::atomic<std::size_t> done_chunks {0};
+                        std::mutex error_mutex;
+                        std::exception_ptr error;
+                    };
+                    auto state = std::make_shared<section_state>();
+                    auto *func_ptr = &func;
+
+                    // Helpers may start after the section is over: they then find no chunk left and never touch func.
+                    auto run_chunks = [state, func_ptr, begin, end, chunk_size, chunks_num]() {
+                        while (true) {
+                            std::size_t chunk = state->next_chunk.fetch_add(1);
+                            if (chunk >= chunks_num) {
+                                break;
+                            }
+                            std::size_t chunk_begin = begin + chunk * chunk_size;
+                            std::size_t chunk_end = std::min(end, chunk_begin + chunk_size);
+                            try {
+                                (*func_ptr)(chunk_begin, chunk_end);
+                            } catch (...) {
+                                std::lock_guard<std::mutex> lock(state->error_mutex);
+                                if (!state->error) {
+                                    state->error = std::current_exception();
+                                }
+                            }
+                            state->done_chunks.fetch_add(1);
+                        }
+                    };
+
+                    std::size_t helpers_num = std::min(pool.size() - 1, chunks_num - 1);
+                    for (std::size_t i = 0; i < helpers_num; i++) {
+                        pool.submit(run_chunks);
+                    }
+                    run_chunks();
+
+                    while (state->done_chunks.load() < chunks_num) {
+                        if (!pool.try_run_pending_task()) {
+                            std::this_thread::yield();
+                        }
+                    }
+
+                    if (state->error) {
+                        std::rethrow_exception(state->error);
+                    }
+                }
+
+                // Calls func(i) for every i in [begin, end).
+                template<typename FuncType>
+                void parallel_for(std::size_t begin, std::size_t end, FuncType &&func, std::size_t grain_size = 1,
+                                  thread_pool &pool = thread_pool::instance()) {
+                    parallel_for_chunks(
+                        begin, end,
+                        [&func](std::size_t chunk_begin, std::size_t chunk_end) {
+                            for (std::size_t i = chunk_begin; i < chunk_end; i++) {
+                                func(i);
+                            }
+                        },
+                        grain_size, pool);
+                }
+
+                // Runs independent tasks concurrently and waits for all of them.
+                inline void parallel_invoke(const std::vector<std::function<void()>> &tasks,
+                                            thread_pool &pool = thread_pool::instance()) {
+                    parallel_for(0, tasks.size(), [&tasks](std::size_t i) { tasks[i](); }, 1, pool);
+                }
+            }    // namespace detail
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_DETAIL_PARALLELIZATION_HPP
@@ -0,0 +1,183 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_DETAIL_TASK_GRAPH_HPP
+#define CRYPTO3_ZK_DETAIL_TASK_GRAPH_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <nil/crypto3/zk/detail/thread_pool.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace detail {
+
+                /**
+                 * @brief Tasks with dependencies run on the thread pool.
+                 *
+                 * A task is submitted as soon as all the tasks it depends on are finished, so independent
+                 * stages overlap. Tasks may open parallel sections of their own on the same pool.
+                 * Tasks with the same name are reported together by timings(), which is how a stage split
+                 * into several parts is measured.
+                 */
+                class task_graph {
+                public:
+                    typedef std::size_t task_id;
+                    typedef std::chrono::steady_clock clock_type;
+
+                    struct task_timing {
+                        // From the start of run() to the start of the first part and to the end of the last one.
+                        clock_type::duration start = clock_type::duration::zero();
+                        clock_type::duration end = clock_type::duration::zero();
+                        // Summed over the parts.
+                        clock_type::duration busy = clock_type::duration::zero();
+                    };
+
+                    task_graph() = default;
+                    task_graph(const task_graph &) = delete;
+                    task_graph &operator=(const task_graph &) = delete;
+
+                    // Dependencies are tasks added before.
+                    task_id add(const std::string &name, std::function<void()> func,
+                                const std::vector<task_id> &dependencies = {}) {
+                        task_id id = _nodes.size();
+                        _nodes.emplace_back(new node_type());
+                        _nodes[id]->name = name;
+                        _nodes[id]->func = std::move(func);
+                        _nodes[id]->dependencies_num = dependencies.size();
+                        for (task_id dependency : dependencies) {
+                            BOOST_ASSERT(dependency < id);
+                            _nodes[dependency]->successors.push_back(id);
+                        }
+                        return id;
+                    }
+
+                    // Runs all the tasks and returns when they are finished. The first exception thrown by a task
+                    // is rethrown, the tasks depending on a failed one are skipped.
+                    void run(thread_pool &pool = thread_pool::instance()) {
+                        _start = clock_type::now();
+                        _done = 0;
+                        _error = nullptr;
+                        for (auto &node : _nodes) {
+                            node->remaining = node->dependencies_num;
+                            node->failed = false;
+                        }
+
+                        for (task_id id = 0; id < _nodes.size(); id++) {
+                            if (_nodes[id]->dependencies_num == 0) {
+                                submit(id, pool);
+                            }
+                        }
+                        while (_done.load() < _nodes.size()) {
+                            if (!pool.try_run_pending_task()) {
+                                std::this_thread::yield();
+                            }
+                        }
+
+                        if (_error) {
+                            std::rethrow_exception(_error);
+                        }
+                    }
+
+                    std::map<std::string, task_timing> timings() const {
+                        std::map<std::string, task_timing> result;
+                        for (const auto &node : _nodes) {
+                            auto it = result.find(node->name);
+                            if (it == result.end()) {
+                                result[node->name] = {node->start, node->end, node->end - node->start};
+                                continue;
+                            }
+                            it->second.start = std::min(it->second.start, node->start);
+                            it->second.end = std::max(it->second.end, node->end);
+                            it->second.busy += node->end - node->start;
+                        }
+                        return result;
+                    }
+
+                private:
+                    struct node_type {
+                        std::string name;
+                        std::function<void()> func;
+                        std::vector<task_id> successors;
+                        std::size_t dependencies_num = 0;
+                        std::atomic<std::size_t> remaining {0};
+                        std::atomic<bool> failed {false};
+                        clock_type::duration start = clock_type::duration::zero();
+                        clock_type::duration end = clock_type::duration::zero();
+                    };
+
+                    void submit(task_id id, thread_pool &pool) {
+                        pool.submit([this, id, &pool]() {
+                            node_type &node = *_nodes[id];
+                            node.start = clock_type::now() - _start;
+                            if (!node.failed.load()) {
+                                try {
+                                    node.func();
+                                } catch (...) {
+                                    std::lock_guard<std::mutex> lock(_error_mutex);
+                                    if (!_error) {
+                                        _error = std::current_exception();
+                                    }
+                                    node.failed = true;
+                                }
+                            }
+                            node.end = clock_type::now() - _start;
+
+                            for (task_id successor : node.successors) {
+                                if (node.failed.load()) {
+                                    _nodes[successor]->failed = true;
+                                }
+                                if (_nodes[successor]->remaining.fetch_sub(1) == 1) {
+                                    submit(successor, pool);
+                                }
+                            }
+                            _done.fetch_add(1);
+                        });
+                    }
+
+                    std::vector<std::unique_ptr<node_type>> _nodes;
+                    clock_type::time_point _start;
+                    std::atomic<std::size_t> _done {0};
+                    std::mutex _error_mutex;
+                    std::exception_ptr _error;
+                };
+            }    // namespace detail
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_DETAIL_TASK_GRAPH_HPP
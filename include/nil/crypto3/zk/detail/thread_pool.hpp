@@ -0,0 +1,222 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_DETAIL_THREAD_POOL_HPP
+#define CRYPTO3_ZK_DETAIL_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace detail {
+
+                /**
+                 * @brief Work-stealing thread pool used by the provers.
+                 *
+                 * Every worker owns a task deque. A worker takes its own tasks from the back of its deque
+                 * and steals from the front of other deques when it runs out of work. Tasks submitted from
+                 * a worker go to that worker's deque, tasks submitted from outside are spread round-robin.
+                 *
+                 * A pool of size 1 does not start any threads: every task is executed by the caller, which
+                 * is the default behaviour of the global instance.
+                 */
+                class thread_pool {
+                public:
+                    typedef std::function<void()> task_type;
+
+                    // Global pool shared by all prover stages, configured with resize().
+                    static thread_pool &instance() {
+                        static thread_pool pool(1);
+                        return pool;
+                    }
+
+                    explicit thread_pool(std::size_t threads_num = std::thread::hardware_concurrency()) {
+                        start(threads_num);
+                    }
+
+                    thread_pool(const thread_pool &) = delete;
+                    thread_pool &operator=(const thread_pool &) = delete;
+
+                    ~thread_pool() {
+                        stop();
+                    }
+
+                    // Number of threads taking part in parallel sections, including the calling one.
+                    std::size_t size() const {
+                        return _workers.size() + 1;
+                    }
+
+                    // Must not be called while a parallel section is running on this pool.
+                    void resize(std::size_t threads_num) {
+                        stop();
+                        start(threads_num);
+                    }
+
+                    // Tasks are expected not to throw, exceptions must be handled inside of them.
+                    void submit(task_type task) {
+                        if (_workers.empty()) {
+                            task();
+                            return;
+                        }
+
+                        std::size_t queue_index = (current_pool() == this) ?
+                                                      current_worker_index() :
+                                                      _next_queue.fetch_add(1) % _queues.size();
+                        // Counted before it becomes visible, so a worker popping it never takes _pending below zero.
+                        {
+                            std::lock_guard<std::mutex> lock(_wake_mutex);
+                            ++_pending;
+                        }
+                        {
+                            std::lock_guard<std::mutex> lock(_queues[queue_index]->mutex);
+                            _queues[queue_index]->tasks.push_back(std::move(task));
+                        }
+                        _wake_condition.notify_one();
+                    }
+
+                    // Runs one pending task in the calling thread. Used by threads waiting for a parallel section.
+                    bool try_run_pending_task() {
+                        task_type task;
+                        std::size_t own_index = (current_pool() == this) ? current_worker_index() : _queues.size();
+                        if (!pop_task(own_index, task)) {
+                            return false;
+                        }
+                        task();
+                        return true;
+                    }
+
+                private:
+                    struct task_queue {
+                        std::mutex mutex;
+                        std::deque<task_type> tasks;
+                    };
+
+                    static thread_pool *&current_pool() {
+                        static thread_local thread_pool *pool = nullptr;
+                        return pool;
+                    }
+
+                    static std::size_t &current_worker_index() {
+                        static thread_local std::size_t index = 0;
+                        return index;
+                    }
+
+                    void start(std::size_t threads_num) {
+                        _stop = false;
+                        _pending = 0;
+                        if (threads_num <= 1) {
+                            return;
+                        }
+
+                        for (std::size_t i = 0; i < threads_num - 1; i++) {
+                            _queues.emplace_back(new task_queue());
+                        }
+                        for (std::size_t i = 0; i < threads_num - 1; i++) {
+                            _workers.emplace_back(&thread_pool::worker_loop, this, i);
+                        }
+                    }
+
+                    void stop() {
+                        {
+                            std::lock_guard<std::mutex> lock(_wake_mutex);
+                            _stop = true;
+                        }
+                        _wake_condition.notify_all();
+                        for (auto &worker : _workers) {
+                            worker.join();
+                        }
+                        _workers.clear();
+                        _queues.clear();
+                    }
+
+                    // Own deque is used as a stack, other deques are robbed from the opposite end.
+                    bool pop_task(std::size_t own_index, task_type &task) {
+                        if (own_index < _queues.size()) {
+                            std::lock_guard<std::mutex> lock(_queues[own_index]->mutex);
+                            if (!_queues[own_index]->tasks.empty()) {
+                                task = std::move(_queues[own_index]->tasks.back());
+                                _queues[own_index]->tasks.pop_back();
+                                --_pending;
+                                return true;
+                            }
+                        }
+                        for (std::size_t i = 0; i < _queues.size(); i++) {
+                            std::size_t victim = (own_index + 1 + i) % _queues.size();
+                            if (victim == own_index) {
+                                continue;
+                            }
+                            std::lock_guard<std::mutex> lock(_queues[victim]->mutex);
+                            if (!_queues[victim]->tasks.empty()) {
+                                task = std::move(_queues[victim]->tasks.front());
+                                _queues[victim]->tasks.pop_front();
+                                --_pending;
+                                return true;
+                            }
+                        }
+                        return false;
+                    }
+
+                    void worker_loop(std::size_t index) {
+                        current_pool() = this;
+                        current_worker_index() = index;
+
+                        while (true) {
+                            task_type task;
+                            if (pop_task(index, task)) {
+                                task();
+                                continue;
+                            }
+
+                            std::unique_lock<std::mutex> lock(_wake_mutex);
+                            _wake_condition.wait(lock, [this]() { return _stop || _pending.load() > 0; });
+                            if (_stop && _pending.load() == 0) {
+                                break;
+                            }
+                        }
+
+                        current_pool() = nullptr;
+                    }
+
+                    std::vector<std::unique_ptr<task_queue>> _queues;
+                    std::vector<std::thread> _workers;
+                    std::atomic<std::size_t> _next_queue {0};
+                    std::atomic<std::size_t> _pending {0};
+                    std::mutex _wake_mutex;
+                    std::condition_variable _wake_condition;
+                    bool _stop = false;
+                };
+            }    // namespace detail
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_DETAIL_THREAD_POOL_HPP
@@ -0,0 +1,426 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Martun Karapetyan <martun@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Lowers math::expression into a flat register program.
+//
+// The expression tree is first turned into SSA form with value numbering, so every
+// distinct subexpression is computed only once. Registers are then assigned with a linear scan,
+// a register is reused as soon as the value it holds is not needed any more.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_MATH_EXPRESSION_COMPILER_HPP
+#define CRYPTO3_ZK_MATH_EXPRESSION_COMPILER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/variant/static_visitor.hpp>
+#include <boost/variant/apply_visitor.hpp>
+
+#include <nil/crypto3/zk/math/expression.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+
+            enum class expression_opcode : std::uint8_t {
+                ADD = 0,
+                SUB = 1,
+                MULT = 2,
+                POW = 3
+            };
+
+            // An operand of an instruction: a register, an input variable or a constant.
+            struct expression_operand {
+                enum class kind_type : std::uint8_t {
+                    REGISTER = 0,
+                    VARIABLE = 1,
+                    CONSTANT = 2
+                };
+
+                kind_type kind;
+                std::uint32_t index;
+
+                bool operator==(const expression_operand &other) const {
+                    return kind == other.kind && index == other.index;
+                }
+
+                bool operator!=(const expression_operand &other) const {
+                    return !(*this == other);
+                }
+
+                bool operator<(const expression_operand &other) const {
+                    return std::tie(kind, index) < std::tie(other.kind, other.index);
+                }
+            };
+
+            struct expression_instruction {
+                expression_opcode op;
+                // Destination register.
+                std::uint32_t dst;
+                expression_operand lhs;
+                // POW repeats lhs here.
+                expression_operand rhs;
+                // Used by POW only.
+                std::uint32_t power;
+            };
+
+            template<typename VariableType>
+            class expression_compiler;
+
+            // The result of expression_compiler, evaluated with compiled_expression_evaluator.
+            template<typename VariableType>
+            class compiled_expression {
+            public:
+                using ValueType = typename VariableType::assignment_type;
+
+                // Distinct variables of the expression, the program refers to them by index.
+                const std::vector<VariableType> &variables() const {
+                    return _variables;
+                }
+
+                const std::vector<ValueType> &constants() const {
+                    return _constants;
+                }
+
+                const std::vector<expression_instruction> &instructions() const {
+                    return _instructions;
+                }
+
+                std::size_t registers_number() const {
+                    return _registers_number;
+                }
+
+                const expression_operand &result() const {
+                    return _result;
+                }
+
+            private:
+                friend class expression_compiler<VariableType>;
+
+                std::vector<VariableType> _variables;
+                std::vector<ValueType> _constants;
+                std::vector<expression_instruction> _instructions;
+                std::size_t _registers_number = 0;
+                expression_operand _result = {expression_operand::kind_type::CONSTANT, 0};
+            };
+
+            // Lowers an expression tree into a compiled_expression.
+            template<typename VariableType>
+            class expression_compiler : public boost::static_visitor<expression_operand> {
+            public:
+                using ValueType = typename VariableType::assignment_type;
+
+                static compiled_expression<VariableType> compile(const math::expression<VariableType> &expr) {
+                    expression_compiler<VariableType> compiler;
+                    expression_operand result = boost::apply_visitor(compiler, expr.get_expr());
+                    return compiler.allocate_registers(result);
+                }
+
+                expression_operand operator()(const math::term<VariableType> &term) {
+                    if (term.get_vars().empty()) {
+                        return constant_operand(term.get_coeff());
+                    }
+
+                    // Multiplication is commutative, sorted variables let equal products share the code.
+                    std::vector<VariableType> vars = term.get_vars();
+                    std::sort(vars.begin(), vars.end());
+
+                    expression_operand result = variable_operand(vars[0]);
+                    for (std::size_t i = 1; i < vars.size(); i++) {
+                        result = emit(expression_opcode::MULT, result, variable_operand(vars[i]));
+                    }
+                    if (!term.get_coeff().is_one()) {
+                        result = emit(expression_opcode::MULT, result, constant_operand(term.get_coeff()));
+                    }
+                    return result;
+                }
+
+                expression_operand operator()(const math::pow_operation<VariableType> &pow) {
+                    expression_operand base = boost::apply_visitor(*this, pow.get_expr().get_expr());
+                    BOOST_ASSERT(pow.get_power() >= 0);
+                    if (pow.get_power() == 1) {
+                        return base;
+                    }
+                    return emit(expression_opcode::POW, base, base, pow.get_power());
+                }
+
+                expression_operand operator()(const math::binary_arithmetic_operation<VariableType> &op) {
+                    expression_operand left = boost::apply_visitor(*this, op.get_expr_left().get_expr());
+                    expression_operand right = boost::apply_visitor(*this, op.get_expr_right().get_expr());
+                    switch (op.get_op()) {
+                        case ArithmeticOperator::ADD:
+                            return emit(expression_opcode::ADD, left, right);
+                        case ArithmeticOperator::SUB:
+                            return emit(expression_opcode::SUB, left, right);
+                        case ArithmeticOperator::MULT:
+                            return emit(expression_opcode::MULT, left, right);
+                    }
+                    BOOST_ASSERT(false);
+                    return left;
+                }
+
+            private:
+                using ssa_key_type = std::tuple<expression_opcode, expression_operand, expression_operand, std::uint32_t>;
+
+                expression_compiler() = default;
+
+                expression_operand variable_operand(const VariableType &var) {
+                    auto it = _variable_ids.find(var);
+                    if (it != _variable_ids.end()) {
+                        return {expression_operand::kind_type::VARIABLE, it->second};
+                    }
+                    std::uint32_t id = _program._variables.size();
+                    _program._variables.push_back(var);
+                    _variable_ids[var] = id;
+                    return {expression_operand::kind_type::VARIABLE, id};
+                }
+
+                expression_operand constant_operand(const ValueType &value) {
+                    auto it = _constant_ids.find(value);
+                    if (it != _constant_ids.end()) {
+                        return {expression_operand::kind_type::CONSTANT, it->second};
+                    }
+                    std::uint32_t id = _program._constants.size();
+                    _program._constants.push_back(value);
+                    _constant_ids[value] = id;
+                    return {expression_operand::kind_type::CONSTANT, id};
+                }
+
+                // Appends an SSA instruction, unless the same value was already computed.
+                // Here REGISTER operands refer to SSA values.
+                expression_operand emit(expression_opcode op, expression_operand lhs, expression_operand rhs,
+                                        std::uint32_t power = 0) {
+                    if ((op == expression_opcode::ADD || op == expression_opcode::MULT) && rhs < lhs) {
+                        std::swap(lhs, rhs);
+                    }
+                    ssa_key_type key(op, lhs, rhs, power);
+                    auto it = _ssa_ids.find(key);
+                    if (it != _ssa_ids.end()) {
+                        return {expression_operand::kind_type::REGISTER, it->second};
+                    }
+                    std::uint32_t id = _ssa.size();
+                    _ssa.push_back({op, id, lhs, rhs, power});
+                    _ssa_ids[key] = id;
+                    return {expression_operand::kind_type::REGISTER, id};
+                }
+
+                // Maps SSA values to registers with a linear scan. A register is released right after
+                // the last use of its value, so the destination of an instruction often reuses one of the
+                // operand registers and is updated in place.
+                compiled_expression<VariableType> allocate_registers(const expression_operand &result) {
+                    constexpr std::size_t never = std::numeric_limits<std::size_t>::max();
+
+                    std::vector<std::size_t> last_use(_ssa.size(), 0);
+                    for (std::size_t i = 0; i < _ssa.size(); i++) {
+                        for (const expression_operand *operand : {&_ssa[i].lhs, &_ssa[i].rhs}) {
+                            if (operand->kind == expression_operand::kind_type::REGISTER) {
+                                last_use[operand->index] = i;
+                            }
+                        }
+                    }
+                    if (result.kind == expression_operand::kind_type::REGISTER) {
+                        last_use[result.index] = never;
+                    }
+
+                    std::vector<std::uint32_t> register_of(_ssa.size());
+                    std::vector<std::uint32_t> free_registers;
+                    std::uint32_t registers_number = 0;
+
+                    for (std::size_t i = 0; i < _ssa.size(); i++) {
+                        expression_instruction instruction = _ssa[i];
+                        const bool commutative =
+                            instruction.op == expression_opcode::ADD || instruction.op == expression_opcode::MULT;
+
+                        // x * x and POW release their single operand once.
+                        const bool same_operands = instruction.lhs == instruction.rhs;
+                        std::uint32_t dst = std::numeric_limits<std::uint32_t>::max();
+                        for (expression_operand *operand : {&instruction.lhs, &instruction.rhs}) {
+                            if (operand->kind != expression_operand::kind_type::REGISTER) {
+                                continue;
+                            }
+                            std::uint32_t reg = register_of[operand->index];
+                            bool released = last_use[operand->index] == i &&
+                                            (operand == &instruction.lhs || !same_operands);
+                            operand->index = reg;
+                            if (!released) {
+                                continue;
+                            }
+                            // Prefer the left operand, the right one only if the operands may be swapped.
+                            if (dst == std::numeric_limits<std::uint32_t>::max() &&
+                                (operand == &instruction.lhs || commutative)) {
+                                dst = reg;
+                            } else {
+                                free_registers.push_back(reg);
+                            }
+                        }
+                        if (dst == std::numeric_limits<std::uint32_t>::max()) {
+                            if (!free_registers.empty()) {
+                                dst = free_registers.back();
+                                free_registers.pop_back();
+                            } else {
+                                dst = registers_number++;
+                            }
+                        }
+
+                        instruction.dst = dst;
+                        register_of[i] = dst;
+                        _program._instructions.push_back(instruction);
+                    }
+
+                    _program._registers_number = registers_number;
+                    _program._result = result;
+                    if (result.kind == expression_operand::kind_type::REGISTER) {
+                        _program._result.index = register_of[result.index];
+                    }
+                    return std::move(_program);
+                }
+
+                compiled_expression<VariableType> _program;
+                std::vector<expression_instruction> _ssa;
+                std::map<ssa_key_type, std::uint32_t> _ssa_ids;
+                std::unordered_map<VariableType, std::uint32_t> _variable_ids;
+                std::unordered_map<ValueType, std::uint32_t> _constant_ids;
+            };
+
+            // Runs a compiled_expression. Registers are updated in place, for polynomial_dfs operands
+            // it means a register keeps its buffer while it is reused by the following instructions.
+            template<typename VariableType>
+            class compiled_expression_evaluator {
+            public:
+                using ValueType = typename VariableType::assignment_type;
+
+                /*
+                 * @param program - the compiled expression, it must outlive the evaluator.
+                 * @param get_var_value - A function which can return the value for a given variable.
+                 */
+                compiled_expression_evaluator(
+                    const compiled_expression<VariableType> &program,
+                    std::function<ValueType(const VariableType &)> get_var_value)
+                        : _program(program)
+                        , _get_var_value(get_var_value) {
+                }
+
+                ValueType evaluate() const {
+                    std::vector<ValueType> inputs;
+                    inputs.reserve(_program.variables().size());
+                    for (const auto &var : _program.variables()) {
+                        inputs.push_back(_get_var_value(var));
+                    }
+
+                    std::vector<const ValueType *> input_refs(inputs.size());
+                    for (std::size_t i = 0; i < inputs.size(); i++) {
+                        input_refs[i] = &inputs[i];
+                    }
+                    return evaluate(_program, input_refs);
+                }
+
+                // Evaluates the program over values that are already stored somewhere, without copying them.
+                // inputs[i] holds the value of program.variables()[i].
+                static ValueType evaluate(const compiled_expression<VariableType> &program,
+                                          const std::vector<const ValueType *> &inputs) {
+                    BOOST_ASSERT(inputs.size() == program.variables().size());
+
+                    std::vector<ValueType> registers(program.registers_number());
+                    auto value = [&registers, &inputs, &program](const expression_operand &operand) -> const ValueType & {
+                        switch (operand.kind) {
+                            case expression_operand::kind_type::REGISTER:
+                                return registers[operand.index];
+                            case expression_operand::kind_type::VARIABLE:
+                                return *inputs[operand.index];
+                            case expression_operand::kind_type::CONSTANT:
+                                break;
+                        }
+                        return program.constants()[operand.index];
+                    };
+                    auto is_register = [](const expression_operand &operand, std::uint32_t reg) {
+                        return operand.kind == expression_operand::kind_type::REGISTER && operand.index == reg;
+                    };
+
+                    for (const auto &instruction : program.instructions()) {
+                        ValueType &dst = registers[instruction.dst];
+                        if (instruction.op == expression_opcode::POW) {
+                            dst = value(instruction.lhs).pow(instruction.power);
+                            continue;
+                        }
+
+                        if (is_register(instruction.lhs, instruction.dst) && is_register(instruction.rhs, instruction.dst)) {
+                            ValueType rhs = dst;
+                            apply(instruction.op, dst, rhs);
+                        } else if (is_register(instruction.lhs, instruction.dst)) {
+                            apply(instruction.op, dst, value(instruction.rhs));
+                        } else if (is_register(instruction.rhs, instruction.dst)) {
+                            if (instruction.op == expression_opcode::SUB) {
+                                ValueType result = value(instruction.lhs);
+                                result -= dst;
+                                dst = std::move(result);
+                            } else {
+                                apply(instruction.op, dst, value(instruction.lhs));
+                            }
+                        } else {
+                            dst = value(instruction.lhs);
+                            apply(instruction.op, dst, value(instruction.rhs));
+                        }
+                    }
+
+                    if (program.result().kind == expression_operand::kind_type::REGISTER) {
+                        return std::move(registers[program.result().index]);
+                    }
+                    return value(program.result());
+                }
+
+            private:
+                static void apply(expression_opcode op, ValueType &dst, const ValueType &other) {
+                    switch (op) {
+                        case expression_opcode::ADD:
+                            dst += other;
+                            break;
+                        case expression_opcode::SUB:
+                            dst -= other;
+                            break;
+                        case expression_opcode::MULT:
+                            dst *= other;
+                            break;
+                        case expression_opcode::POW:
+                            BOOST_ASSERT(false);
+                            break;
+                    }
+                }
+
+                const compiled_expression<VariableType> &_program;
+
+                // A function used to retrieve the value of a variable.
+                std::function<ValueType(const VariableType &var)> _get_var_value;
+            };
+        }    // namespace math
+    }    // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_MATH_EXPRESSION_COMPILER_HPP
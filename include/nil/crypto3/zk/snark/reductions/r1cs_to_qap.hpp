@@ -48,6 +48,10 @@
 #ifndef CRYPTO3_ZK_R1CS_TO_QAP_BASIC_POLICY_HPP
 #define CRYPTO3_ZK_R1CS_TO_QAP_BASIC_POLICY_HPP
 
+#include <array>
+#include <memory>
+#include <vector>
+
 #include <nil/crypto3/math/coset.hpp>
 #include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
 
@@ -56,11 +60,61 @@
 
 #include <nil/crypto3/algebra/fields/params.hpp>
 
+#include <nil/crypto3/zk/detail/parallelization.hpp>
+#include <nil/crypto3/zk/detail/thread_pool.hpp>
+
 namespace nil {
     namespace crypto3 {
         namespace zk {
             namespace snark {
                 namespace reductions {
+
+                    /**
+                     * Scratch memory of r1cs_to_qap::witness_map, kept by a caller that maps many witnesses of
+                     * circuits of the same size. The evaluation domains are built once for a size and the column
+                     * buffers keep their capacity between the calls.
+                     * A workspace is used by one witness_map call at a time.
+                     */
+                    template<typename FieldType>
+                    class r1cs_to_qap_workspace {
+                    public:
+                        typedef typename FieldType::value_type value_type;
+                        typedef std::shared_ptr<math::evaluation_domain<FieldType>> domain_ptr_type;
+
+                        // With concurrent_transforms the FFTs of the columns run at the same time, on a domain per
+                        // column: the domains for fields of small 2-adicity precompute lazily. Otherwise a single
+                        // domain is built and the columns are transformed one after another.
+                        explicit r1cs_to_qap_workspace(bool concurrent_transforms = true) :
+                            _concurrent_transforms(concurrent_transforms) {
+                        }
+
+                        // Evaluation domains for min_size, for the columns of A, B and C.
+                        const std::array<domain_ptr_type, 3> &domains(std::size_t min_size) {
+                            if (!_domains[0] || _min_size != min_size) {
+                                _domains[0] = math::make_evaluation_domain<FieldType>(min_size);
+                                for (std::size_t k = 1; k < _domains.size(); k++) {
+                                    _domains[k] = _concurrent_transforms ?
+                                                      math::make_evaluation_domain<FieldType>(min_size) :
+                                                      _domains[0];
+                                }
+                                _min_size = min_size;
+                            }
+                            return _domains;
+                        }
+
+                        bool concurrent_transforms() const {
+                            return _concurrent_transforms;
+                        }
+
+                        // Values of A, B and C on the domain, then on its coset.
+                        std::array<std::vector<value_type>, 3> columns;
+
+                    private:
+                        bool _concurrent_transforms;
+                        std::size_t _min_size = 0;
+                        std::array<domain_ptr_type, 3> _domains;
+                    };
+
                     template<typename FieldType>
                     struct r1cs_to_qap {
                         typedef FieldType field_type;
@@ -223,106 +277,121 @@ namespace nil {
                                         const typename FieldType::value_type &d1,
                                         const typename FieldType::value_type &d2,
                                         const typename FieldType::value_type &d3) {
+                            r1cs_to_qap_workspace<FieldType> workspace(false);
+                            return witness_map(cs, primary_input, auxiliary_input, d1, d2, d3, workspace);
+                        }
+
+                        /**
+                         * Witness map with the scratch memory and the evaluation domains of workspace.
+                         *
+                         * The rows of A, B and C are evaluated in parallel by chunks of constraints, and with
+                         * concurrent transforms in the workspace the FFTs of the three columns run at the same time.
+                         * This keeps aA, aB and aC alive together, where the serial version freed aB before
+                         * computing aC.
+                         */
+                        static qap_witness<FieldType>
+                            witness_map(const r1cs_constraint_system<FieldType> &cs,
+                                        const r1cs_primary_input<FieldType> &primary_input,
+                                        const r1cs_auxiliary_input<FieldType> &auxiliary_input,
+                                        const typename FieldType::value_type &d1,
+                                        const typename FieldType::value_type &d2,
+                                        const typename FieldType::value_type &d3,
+                                        r1cs_to_qap_workspace<FieldType> &workspace) {
+                            typedef typename FieldType::value_type value_type;
+
                             /* sanity check */
                             assert(cs.is_satisfied(primary_input, auxiliary_input));
 
-                            const std::shared_ptr<math::evaluation_domain<FieldType>> domain =
-                                math::make_evaluation_domain<FieldType>(cs.num_constraints() + cs.num_inputs() + 1);
+                            const auto &domains = workspace.domains(cs.num_constraints() + cs.num_inputs() + 1);
+                            const std::shared_ptr<math::evaluation_domain<FieldType>> &domain = domains[0];
+                            const std::size_t m = domain->m;
 
                             r1cs_variable_assignment<FieldType> full_variable_assignment = primary_input;
                             full_variable_assignment.insert(full_variable_assignment.end(), auxiliary_input.begin(),
                                                             auxiliary_input.end());
 
-                            std::vector<typename FieldType::value_type> aA(domain->m, FieldType::value_type::zero()),
-                                aB(domain->m, FieldType::value_type::zero());
+                            std::vector<value_type> &aA = workspace.columns[0];
+                            std::vector<value_type> &aB = workspace.columns[1];
+                            std::vector<value_type> &aC = workspace.columns[2];
+                            for (std::vector<value_type> &column : workspace.columns) {
+                                column.assign(m, value_type::zero());
+                            }
 
                             /* account for the additional constraints input_i * 0 = 0 */
                             for (std::size_t i = 0; i <= cs.num_inputs(); ++i) {
                                 aA[i + cs.num_constraints()] =
-                                    (i > 0 ? full_variable_assignment[i - 1] : FieldType::value_type::one());
+                                    (i > 0 ? full_variable_assignment[i - 1] : value_type::one());
                             }
                             /* account for all other constraints */
-                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
-                                aA[i] += cs.constraints[i].a.evaluate(full_variable_assignment);
-                                aB[i] += cs.constraints[i].b.evaluate(full_variable_assignment);
-                            }
-
-                            domain->inverse_fft(aA);
-
-                            domain->inverse_fft(aB);
+                            pointwise(cs.num_constraints(), [&](std::size_t i) {
+                                aA[i] = cs.constraints[i].a.evaluate(full_variable_assignment);
+                                aB[i] = cs.constraints[i].b.evaluate(full_variable_assignment);
+                                aC[i] = cs.constraints[i].c.evaluate(full_variable_assignment);
+                            }, 256);
+
+                            auto for_each_column = [&workspace](auto func) {
+                                if (workspace.concurrent_transforms()) {
+                                    zk::detail::parallel_for(0, workspace.columns.size(), func);
+                                } else {
+                                    for (std::size_t k = 0; k < workspace.columns.size(); k++) {
+                                        func(k);
+                                    }
+                                }
+                            };
+                            for_each_column([&](std::size_t k) {
+                                domains[k]->inverse_fft(workspace.columns[k]);
+                            });
 
-                            std::vector<typename FieldType::value_type> coefficients_for_H(
-                                domain->m + 1, FieldType::value_type::zero());
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
+                            std::vector<value_type> coefficients_for_H(m + 1, value_type::zero());
                             /* add coefficients of the polynomial (d2*A + d1*B - d3) + d1*d2*Z */
-                            for (std::size_t i = 0; i < domain->m; ++i) {
+                            pointwise(m, [&](std::size_t i) {
                                 coefficients_for_H[i] = d2 * aA[i] + d1 * aB[i];
-                            }
+                            }, 4096);
                             coefficients_for_H[0] -= d3;
                             domain->add_poly_z(d1 * d2, coefficients_for_H);
 
-                            math::multiply_by_coset(
-                                aA,
-                                typename FieldType::value_type(
-                                    fields::arithmetic_params<FieldType>::multiplicative_generator));
-                            domain->fft(aA);
+                            const value_type coset_generator(
+                                fields::arithmetic_params<FieldType>::multiplicative_generator);
+                            for_each_column([&](std::size_t k) {
+                                math::multiply_by_coset(workspace.columns[k], coset_generator);
+                                domains[k]->fft(workspace.columns[k]);
+                            });
 
-                            math::multiply_by_coset(
-                                aB,
-                                typename FieldType::value_type(
-                                    fields::arithmetic_params<FieldType>::multiplicative_generator));
-                            domain->fft(aB);
-
-                            std::vector<typename FieldType::value_type> &H_tmp = aA;
+                            std::vector<value_type> &H_tmp = aA;
                             // can overwrite aA because it is not used later
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
-                            for (std::size_t i = 0; i < domain->m; ++i) {
-                                H_tmp[i] = aA[i] * aB[i];
-                            }
-                            std::vector<typename FieldType::value_type>().swap(aB);    // destroy aB
-
-                            std::vector<typename FieldType::value_type> aC(domain->m, FieldType::value_type::zero());
-                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
-                                aC[i] += cs.constraints[i].c.evaluate(full_variable_assignment);
-                            }
-
-                            domain->inverse_fft(aC);
-
-                            math::multiply_by_coset(
-                                aC,
-                                typename FieldType::value_type(
-                                    fields::arithmetic_params<FieldType>::multiplicative_generator));
-                            domain->fft(aC);
-
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
-                            for (std::size_t i = 0; i < domain->m; ++i) {
-                                H_tmp[i] = (H_tmp[i] - aC[i]);
-                            }
+                            pointwise(m, [&](std::size_t i) {
+                                H_tmp[i] = aA[i] * aB[i] - aC[i];
+                            }, 4096);
 
                             domain->divide_by_z_on_coset(H_tmp);
 
                             domain->inverse_fft(H_tmp);
 
-                            multiply_by_coset(H_tmp,
-                                              typename FieldType::value_type(
-                                                  fields::arithmetic_params<FieldType>::multiplicative_generator)
-                                                  .inversed());
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
-                            for (std::size_t i = 0; i < domain->m; ++i) {
+                            math::multiply_by_coset(H_tmp, coset_generator.inversed());
+                            pointwise(m, [&](std::size_t i) {
                                 coefficients_for_H[i] += H_tmp[i];
-                            }
+                            }, 4096);
 
-                            return qap_witness<FieldType>(cs.num_variables(), domain->m, cs.num_inputs(), d1, d2, d3,
+                            return qap_witness<FieldType>(cs.num_variables(), m, cs.num_inputs(), d1, d2, d3,
                                                           full_variable_assignment, std::move(coefficients_for_H));
                         }
+
+                    private:
+                        // func(i) for i in [0, size) on the thread pool. A pool of one thread leaves MULTICORE
+                        // builds to OpenMP, as before.
+                        template<typename FuncType>
+                        static void pointwise(std::size_t size, FuncType func, std::size_t grain_size) {
+#ifdef MULTICORE
+                            if (zk::detail::thread_pool::instance().size() == 1) {
+#pragma omp parallel for
+                                for (std::size_t i = 0; i < size; ++i) {
+                                    func(i);
+                                }
+                                return;
+                            }
+#endif
+                            zk::detail::parallel_for(0, size, func, grain_size);
+                        }
                     };
                 }    // namespace reductions
             }        // namespace snark
@@ -0,0 +1,258 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Evaluation of compiled expressions over rotated views of table columns.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_PLONK_PLACEHOLDER_DFS_EVALUATOR_HPP
+#define CRYPTO3_ZK_PLONK_PLACEHOLDER_DFS_EVALUATOR_HPP
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
+
+#include <nil/crypto3/zk/detail/parallelization.hpp>
+#include <nil/crypto3/zk/math/expression_compiler.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace snark {
+                namespace detail {
+
+                    /**
+                     * A column rotated by an index offset, without a copy. On a domain of size N that contains
+                     * the basic domain of size n, rotation by omega^r is the offset r * N / n.
+                     */
+                    template<typename FieldType>
+                    struct dfs_column_view {
+                        using polynomial_dfs_type = math::polynomial_dfs<typename FieldType::value_type>;
+
+                        const polynomial_dfs_type *column;
+                        std::size_t offset;
+
+                        std::size_t size() const {
+                            return column->size();
+                        }
+
+                        std::size_t degree() const {
+                            return column->degree();
+                        }
+
+                        // Domain sizes are powers of two.
+                        const typename FieldType::value_type &operator[](std::size_t i) const {
+                            return (*column)[(i + offset) & (column->size() - 1)];
+                        }
+
+                        polynomial_dfs_type materialize() const {
+                            if (offset == 0) {
+                                return *column;
+                            }
+                            polynomial_dfs_type result(column->degree(), column->size());
+                            for (std::size_t i = 0; i < result.size(); i++) {
+                                result[i] = (*this)[i];
+                            }
+                            return result;
+                        }
+                    };
+
+                    /**
+                     * Runs a compiled expression with polynomial_dfs values, the variables are given as column views.
+                     * When both operands have the same size and the result fits into it, an instruction is applied
+                     * element by element on the thread pool, reading the rotated columns in place. Otherwise the
+                     * operands are materialized and the polynomial_dfs operators handle the resizing.
+                     */
+                    template<typename FieldType, typename VariableType>
+                    math::polynomial_dfs<typename FieldType::value_type>
+                        evaluate_dfs_program(const math::compiled_expression<VariableType> &program,
+                                             const std::vector<dfs_column_view<FieldType>> &inputs) {
+                        using value_type = typename FieldType::value_type;
+                        using polynomial_dfs_type = math::polynomial_dfs<value_type>;
+                        using operand_kind = math::expression_operand::kind_type;
+
+                        BOOST_ASSERT(inputs.size() == program.variables().size());
+
+                        std::vector<polynomial_dfs_type> registers(program.registers_number());
+                        // Degrees of the register values, the element-wise path does not update polynomial_dfs degrees.
+                        std::vector<std::size_t> register_degrees(program.registers_number(), 0);
+
+                        // Constants are polynomials of degree 0.
+                        auto is_constant = [](const math::expression_operand &operand) {
+                            return operand.kind == operand_kind::CONSTANT;
+                        };
+                        auto operand_size = [&](const math::expression_operand &operand) -> std::size_t {
+                            return operand.kind == operand_kind::REGISTER ? registers[operand.index].size() :
+                                                                             inputs[operand.index].size();
+                        };
+                        auto operand_degree = [&](const math::expression_operand &operand) -> std::size_t {
+                            switch (operand.kind) {
+                                case operand_kind::REGISTER:
+                                    return register_degrees[operand.index];
+                                case operand_kind::VARIABLE:
+                                    return inputs[operand.index].degree();
+                                case operand_kind::CONSTANT:
+                                    break;
+                            }
+                            return 0;
+                        };
+                        auto materialize = [&](const math::expression_operand &operand) -> polynomial_dfs_type {
+                            switch (operand.kind) {
+                                case operand_kind::REGISTER:
+                                    if (registers[operand.index].degree() != register_degrees[operand.index]) {
+                                        polynomial_dfs_type result(register_degrees[operand.index],
+                                                                   registers[operand.index].size());
+                                        std::copy(registers[operand.index].begin(), registers[operand.index].end(),
+                                                  result.begin());
+                                        return result;
+                                    }
+                                    return registers[operand.index];
+                                case operand_kind::VARIABLE:
+                                    return inputs[operand.index].materialize();
+                                case operand_kind::CONSTANT:
+                                    break;
+                            }
+                            return program.constants()[operand.index];
+                        };
+
+                        // dst_i = func(lhs_i, rhs_i) for all i, operands are read in place.
+                        auto elementwise = [&](const math::expression_operand &lhs, const math::expression_operand &rhs,
+                                               std::size_t size, polynomial_dfs_type &dst, auto func) {
+                            auto read = [&](const math::expression_operand &operand, std::size_t i) -> const value_type & {
+                                switch (operand.kind) {
+                                    case operand_kind::REGISTER:
+                                        return registers[operand.index][i];
+                                    case operand_kind::VARIABLE:
+                                        return inputs[operand.index][i];
+                                    case operand_kind::CONSTANT:
+                                        break;
+                                }
+                                return program.constants()[operand.index][0];
+                            };
+                            zk::detail::parallel_for_chunks(0, size, [&](std::size_t begin, std::size_t end) {
+                                for (std::size_t i = begin; i < end; i++) {
+                                    // Every element depends only on the operand elements with the same index,
+                                    // so dst may be one of the operand registers.
+                                    dst[i] = func(read(lhs, i), read(rhs, i));
+                                }
+                            }, 4096);
+                        };
+
+                        for (const auto &instruction : program.instructions()) {
+                            const auto &lhs = instruction.lhs;
+                            const auto &rhs = instruction.rhs;
+
+                            std::size_t size = 0;
+                            bool same_size = true;
+                            for (const math::expression_operand *operand : {&lhs, &rhs}) {
+                                if (is_constant(*operand)) {
+                                    continue;
+                                }
+                                if (size == 0) {
+                                    size = operand_size(*operand);
+                                } else if (size != operand_size(*operand)) {
+                                    same_size = false;
+                                }
+                            }
+
+                            std::size_t degree = 0;
+                            switch (instruction.op) {
+                                case math::expression_opcode::ADD:
+                                case math::expression_opcode::SUB:
+                                    degree = std::max(operand_degree(lhs), operand_degree(rhs));
+                                    break;
+                                case math::expression_opcode::MULT:
+                                    degree = operand_degree(lhs) + operand_degree(rhs);
+                                    break;
+                                case math::expression_opcode::POW:
+                                    degree = operand_degree(lhs) * instruction.power;
+                                    break;
+                            }
+
+                            polynomial_dfs_type &dst = registers[instruction.dst];
+                            if (size != 0 && same_size && degree < size) {
+                                if (dst.size() != size) {
+                                    bool aliased = (lhs.kind == operand_kind::REGISTER && lhs.index == instruction.dst) ||
+                                                   (rhs.kind == operand_kind::REGISTER && rhs.index == instruction.dst);
+                                    BOOST_ASSERT(!aliased);
+                                    dst = polynomial_dfs_type(degree, size);
+                                }
+                                switch (instruction.op) {
+                                    case math::expression_opcode::ADD:
+                                        elementwise(lhs, rhs, size, dst,
+                                                    [](const value_type &a, const value_type &b) { return a + b; });
+                                        break;
+                                    case math::expression_opcode::SUB:
+                                        elementwise(lhs, rhs, size, dst,
+                                                    [](const value_type &a, const value_type &b) { return a - b; });
+                                        break;
+                                    case math::expression_opcode::MULT:
+                                        elementwise(lhs, rhs, size, dst,
+                                                    [](const value_type &a, const value_type &b) { return a * b; });
+                                        break;
+                                    case math::expression_opcode::POW: {
+                                        std::size_t power = instruction.power;
+                                        elementwise(lhs, rhs, size, dst,
+                                                    [power](const value_type &a, const value_type &) { return a.pow(power); });
+                                        break;
+                                    }
+                                }
+                                register_degrees[instruction.dst] = degree;
+                                continue;
+                            }
+
+                            polynomial_dfs_type left = materialize(lhs);
+                            switch (instruction.op) {
+                                case math::expression_opcode::ADD:
+                                    left += materialize(rhs);
+                                    break;
+                                case math::expression_opcode::SUB:
+                                    left -= materialize(rhs);
+                                    break;
+                                case math::expression_opcode::MULT:
+                                    left *= materialize(rhs);
+                                    break;
+                                case math::expression_opcode::POW:
+                                    left = left.pow(instruction.power);
+                                    break;
+                            }
+                            register_degrees[instruction.dst] = left.degree();
+                            dst = std::move(left);
+                        }
+
+                        const auto &result = program.result();
+                        if (result.kind == operand_kind::REGISTER &&
+                            registers[result.index].degree() == register_degrees[result.index]) {
+                            return std::move(registers[result.index]);
+                        }
+                        return materialize(result);
+                    }
+                }    // namespace detail
+            }        // namespace snark
+        }            // namespace zk
+    }                // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_PLONK_PLACEHOLDER_DFS_EVALUATOR_HPP
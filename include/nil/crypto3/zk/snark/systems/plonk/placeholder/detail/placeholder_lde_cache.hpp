@@ -0,0 +1,188 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Declaration of the per-proof cache of shifted and extended table columns.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_PLONK_PLACEHOLDER_LDE_CACHE_HPP
+#define CRYPTO3_ZK_PLONK_PLACEHOLDER_LDE_CACHE_HPP
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
+#include <nil/crypto3/math/polynomial/shift.hpp>
+#include <nil/crypto3/math/domains/evaluation_domain.hpp>
+
+#include <nil/crypto3/zk/detail/parallelization.hpp>
+#include <nil/crypto3/zk/snark/arithmetization/plonk/assignment.hpp>
+#include <nil/crypto3/zk/snark/arithmetization/plonk/variable.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_dfs_evaluator.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace snark {
+                namespace detail {
+
+                    /**
+                     * Table columns shifted by a rotation and extended to a domain size, computed once per proof.
+                     * The gate argument reads its extended columns from here, the lookup argument only takes
+                     * rotated basic-size columns as views, which add no entries.
+                     * get_view() serves a rotated column as an index offset into the unrotated column of the same
+                     * size, so every column is extended once for all its rotations. get() materializes the shifted
+                     * column instead. Concurrent calls are safe, every entry is computed by exactly one thread.
+                     */
+                    template<typename FieldType, typename ParamsType>
+                    class placeholder_lde_cache {
+                    public:
+                        using polynomial_dfs_type = math::polynomial_dfs<typename FieldType::value_type>;
+                        using variable_type = plonk_variable<polynomial_dfs_type>;
+                        using table_type = plonk_polynomial_dfs_table<FieldType, typename ParamsType::arithmetization_params>;
+
+                        placeholder_lde_cache(const table_type &table,
+                                              std::shared_ptr<math::evaluation_domain<FieldType>> basic_domain)
+                            : _table(table), _basic_domain(basic_domain) {
+                        }
+
+                        placeholder_lde_cache(const placeholder_lde_cache &) = delete;
+                        placeholder_lde_cache &operator=(const placeholder_lde_cache &) = delete;
+
+                        const table_type &table() const {
+                            return _table;
+                        }
+
+                        // The column of var shifted by var.rotation and extended to domain_size.
+                        // Unshifted columns of the basic domain size are returned straight from the table.
+                        const polynomial_dfs_type &get(const variable_type &var, std::size_t domain_size) {
+                            if (var.rotation == 0 && domain_size <= _basic_domain->m) {
+                                return column(var);
+                            }
+
+                            entry_type &entry = find_or_insert(key_type(var.type, var.index, var.rotation, domain_size));
+                            std::call_once(entry.flag, [this, &entry, &var, domain_size]() {
+                                if (domain_size <= _basic_domain->m) {
+                                    entry.value = math::polynomial_shift(column(var), var.rotation, _basic_domain->m);
+                                } else {
+                                    entry.value = get(var, _basic_domain->m);
+                                    entry.value.resize(domain_size);
+                                }
+                            });
+                            return entry.value;
+                        }
+
+                        // The column of var shifted by var.rotation, as a view of the unrotated column extended
+                        // to domain_size. Rotation by omega^r is the offset r * domain_size / n there.
+                        dfs_column_view<FieldType> get_view(const variable_type &var, std::size_t domain_size) {
+                            BOOST_ASSERT(domain_size % _basic_domain->m == 0);
+
+                            variable_type unrotated = var;
+                            unrotated.rotation = 0;
+                            const polynomial_dfs_type &column = get(unrotated, domain_size);
+                            BOOST_ASSERT(column.size() == domain_size);
+
+                            std::int64_t blowup = domain_size / _basic_domain->m;
+                            std::int64_t offset = (std::int64_t(var.rotation) * blowup) % std::int64_t(domain_size);
+                            if (offset < 0) {
+                                offset += domain_size;
+                            }
+                            return {&column, std::size_t(offset)};
+                        }
+
+                        // Computes the missing unrotated columns of the given variables on the thread pool.
+                        void prepare(const std::vector<variable_type> &vars, std::size_t domain_size) {
+                            zk::detail::parallel_for(0, vars.size(), [this, &vars, domain_size](std::size_t i) {
+                                variable_type unrotated = vars[i];
+                                unrotated.rotation = 0;
+                                get(unrotated, domain_size);
+                            });
+                        }
+
+                        // Drops the entries of the given domain size to bound the memory used.
+                        // References returned for them before become invalid.
+                        void release(std::size_t domain_size) {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            for (auto it = _entries.begin(); it != _entries.end();) {
+                                if (std::get<3>(it->first) == domain_size) {
+                                    it = _entries.erase(it);
+                                } else {
+                                    ++it;
+                                }
+                            }
+                        }
+
+                        void clear() {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            _entries.clear();
+                        }
+
+                    private:
+                        // (column type, index, rotation, domain size)
+                        using key_type = std::tuple<typename variable_type::column_type, std::size_t, std::int32_t, std::size_t>;
+
+                        struct entry_type {
+                            std::once_flag flag;
+                            polynomial_dfs_type value;
+                        };
+
+                        const polynomial_dfs_type &column(const variable_type &var) const {
+                            switch (var.type) {
+                                case variable_type::column_type::witness:
+                                    return _table.witness(var.index);
+                                case variable_type::column_type::public_input:
+                                    return _table.public_input(var.index);
+                                case variable_type::column_type::constant:
+                                    return _table.constant(var.index);
+                                case variable_type::column_type::selector:
+                                    break;
+                            }
+                            return _table.selector(var.index);
+                        }
+
+                        entry_type &find_or_insert(const key_type &key) {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            std::unique_ptr<entry_type> &entry = _entries[key];
+                            if (!entry) {
+                                entry = std::make_unique<entry_type>();
+                            }
+                            return *entry;
+                        }
+
+                        const table_type &_table;
+                        std::shared_ptr<math::evaluation_domain<FieldType>> _basic_domain;
+
+                        std::mutex _mutex;
+                        std::map<key_type, std::unique_ptr<entry_type>> _entries;
+                    };
+                }    // namespace detail
+            }        // namespace snark
+        }            // namespace zk
+    }                // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_PLONK_PLACEHOLDER_LDE_CACHE_HPP
@@ -40,13 +40,16 @@
 
 #include <nil/crypto3/container/merkle/tree.hpp>
 
+#include <nil/crypto3/zk/detail/parallelization.hpp>
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/gate.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/constraint_system.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/params.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_policy.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_lde_cache.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/constraint.hpp>
 #include <nil/crypto3/zk/math/expression.hpp>
+#include <nil/crypto3/zk/math/expression_compiler.hpp>
 #include <nil/crypto3/zk/math/expression_evaluator.hpp>
 #include <nil/crypto3/zk/math/expression_visitors.hpp>
 
@@ -71,49 +74,18 @@ namespace nil {
 
                     constexpr static const std::size_t argument_size = 1;
 
-                    static inline void build_variable_value_map(
-                        const math::expression<polynomial_dfs_variable_type>& expr,
-                        const plonk_polynomial_dfs_table<FieldType, typename ParamsType::arithmetization_params> &assignments,
-                        std::shared_ptr<math::evaluation_domain<FieldType>> domain,
-                        std::size_t extended_domain_size,
-                        std::unordered_map<polynomial_dfs_variable_type, polynomial_dfs_type>& variable_values_out) {
-
-                        std::unordered_map<polynomial_dfs_variable_type, size_t> variable_counts;
-
-                        math::expression_for_each_variable_visitor<polynomial_dfs_variable_type> visitor(
-                            [&variable_counts](const polynomial_dfs_variable_type& var) {
-                                variable_counts[var]++;
-                        });
-
-                        visitor.visit(expr);
-                        for (const auto& [var, count]: variable_counts) {
-                            // We may have variable values in required sizes in some cases.
-                            if (variable_values_out.find(var) != variable_values_out.end())
-                                continue;
-                            polynomial_dfs_type assignment;
-                            switch (var.type) {
-                                case polynomial_dfs_variable_type::column_type::witness:
-                                    assignment = assignments.witness(var.index);
-                                    break;
-                                case polynomial_dfs_variable_type::column_type::public_input:
-                                    assignment = assignments.public_input(var.index);
-                                    break;
-                                case polynomial_dfs_variable_type::column_type::constant:
-                                    assignment = assignments.constant(var.index);
-                                    break;
-                                case polynomial_dfs_variable_type::column_type::selector:
-                                    assignment = assignments.selector(var.index);
-                                    break;
-                            }
-
-                            if (var.rotation != 0) {
-                                assignment = math::polynomial_shift(assignment, var.rotation, domain->m);
-                            }
-                            if (count > 1) {
-                                assignment.resize(extended_domain_size);
-                            }
-                            variable_values_out[var] = assignment;
-                        }
+                    static inline std::array<polynomial_dfs_type, argument_size>
+                        prove_eval(
+                            const typename policy_type::constraint_system_type &constraint_system,
+                            const plonk_polynomial_dfs_table<FieldType, typename ParamsType::arithmetization_params>
+                                &column_polynomials,
+                            std::shared_ptr<math::evaluation_domain<FieldType>> original_domain,
+                            std::uint32_t max_gates_degree,
+                            const polynomial_dfs_type &mask_polynomial,
+                            transcript_type& transcript) {
+                        detail::placeholder_lde_cache<FieldType, ParamsType> lde_cache(column_polynomials, original_domain);
+                        return prove_eval(constraint_system, column_polynomials, original_domain, max_gates_degree,
+                                          mask_polynomial, transcript, lde_cache);
                     }
 
                     static inline std::array<polynomial_dfs_type, argument_size>
@@ -124,9 +96,12 @@ namespace nil {
                             std::shared_ptr<math::evaluation_domain<FieldType>> original_domain,
                             std::uint32_t max_gates_degree,
                             const polynomial_dfs_type &mask_polynomial,
-                            transcript_type& transcript) {
+                            transcript_type& transcript,
+                            detail::placeholder_lde_cache<FieldType, ParamsType> &lde_cache) {
                         PROFILE_PLACEHOLDER_SCOPE("gate_argument_time");
 
+                        BOOST_ASSERT(&lde_cache.table() == &column_polynomials);
+
                         // max_gates_degree that comes from the outside does not take into account multiplication
                         // by selector.
                         ++max_gates_degree;
@@ -188,23 +163,27 @@ namespace nil {
                             }
                         }
 
-                        std::unordered_map<polynomial_dfs_variable_type, polynomial_dfs_type> variable_values;
                         std::array<polynomial_dfs_type, argument_size> F;
 
                         for (size_t i = 0; i < extended_domain_sizes.size(); ++i) {
                             if (i != 0 && extended_domain_sizes[i] != extended_domain_sizes[i-1]) {
-                                variable_values.clear();
+                                lde_cache.release(extended_domain_sizes[i-1]);
                             }
-                            build_variable_value_map(expressions[i], column_polynomials, original_domain,
-                                extended_domain_sizes[i], variable_values);
 
-                            math::cached_expression_evaluator<polynomial_dfs_variable_type> evaluator(
-                                expressions[i], [&assignments=variable_values, domain_size=extended_domain_sizes[i]](const polynomial_dfs_variable_type &var) {
-                                return assignments[var];
-                            });
+                            math::compiled_expression<polynomial_dfs_variable_type> program =
+                                math::expression_compiler<polynomial_dfs_variable_type>::compile(expressions[i]);
+
+                            // Columns are extended once per proof, rotations are read in place by index offsets.
+                            lde_cache.prepare(program.variables(), extended_domain_sizes[i]);
+                            std::vector<detail::dfs_column_view<FieldType>> inputs;
+                            inputs.reserve(program.variables().size());
+                            for (const auto& var: program.variables()) {
+                                inputs.push_back(lde_cache.get_view(var, extended_domain_sizes[i]));
+                            }
 
-                            F[0] += evaluator.evaluate();
+                            F[0] += detail::evaluate_dfs_program<FieldType>(program, inputs);
                         }
+                        lde_cache.release(extended_domain_sizes.back());
 
                         F[0] *= mask_polynomial;
                         return F;
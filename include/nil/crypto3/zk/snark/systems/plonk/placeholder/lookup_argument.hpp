@@ -29,6 +29,12 @@
 #ifndef CRYPTO3_ZK_PLONK_PLACEHOLDER_LOOKUP_ARGUMENT_HPP
 #define CRYPTO3_ZK_PLONK_PLACEHOLDER_LOOKUP_ARGUMENT_HPP
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 #include <nil/crypto3/math/polynomial/shift.hpp>
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
@@ -38,10 +44,14 @@
 
 #include <nil/crypto3/container/merkle/tree.hpp>
 
+#include <nil/crypto3/zk/detail/grand_product.hpp>
+#include <nil/crypto3/zk/detail/parallelization.hpp>
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
+#include <nil/crypto3/zk/math/expression_compiler.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/lookup_constraint.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/params.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_policy.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_lde_cache.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/preprocessor.hpp>
 
 namespace nil {
@@ -82,49 +92,183 @@ namespace nil {
                         return reduced;
                     };
 
-                    static math::polynomial_dfs<typename FieldType::value_type> get_constraint_tag_from_gate_tag_column(
-                        math::polynomial_dfs<typename FieldType::value_type> tag_column, 
+                    // Lagrange basis polynomial of constraint_id over the tags {0, 1, ..., constraints_num},
+                    // scaled by table_id: the constant table_id / (constraint_id * prod_{i != constraint_id} (constraint_id - i)).
+                    static typename FieldType::value_type get_constraint_tag_factor(
                         std::size_t constraints_num,
-                        std::size_t constraint_id, 
+                        std::size_t constraint_id,
                         std::size_t table_id
                     ){
-                        math::polynomial_dfs<typename FieldType::value_type> result = tag_column;
+                        typename FieldType::value_type denominator = typename FieldType::value_type(constraint_id);
                         for( std::size_t i = 1; i <= constraints_num; i++ ){
                             if( i != constraint_id ){
-                                auto tmp = tag_column - typename FieldType::value_type(i);
-                                tmp /=  (typename FieldType::value_type(constraint_id) - typename FieldType::value_type(i)); 
-                                result *= tmp;
+                                denominator *= typename FieldType::value_type(constraint_id) - typename FieldType::value_type(i);
                             }
                         }
-                        result /= constraint_id;
-                        result *= table_id;
-                        return result;
+                        return typename FieldType::value_type(table_id) * denominator.inversed();
                     }
 
-                    static typename FieldType::value_type get_constraint_tag_value_from_gate_tag_value(
-                        typename FieldType::value_type tag_value, 
+                    // factor * t * prod_{i != constraint_id} (t - i), one scalar pass per point.
+                    static typename FieldType::value_type evaluate_constraint_tag(
+                        const typename FieldType::value_type &tag_value,
+                        const typename FieldType::value_type &factor,
                         std::size_t constraints_num,
-                        std::size_t constraint_id, 
-                        std::size_t table_id
+                        std::size_t constraint_id
                     ){
-                        typename FieldType::value_type result = tag_value;
+                        typename FieldType::value_type result = tag_value * factor;
                         for( std::size_t i = 1; i <= constraints_num; i++ ){
                             if( i != constraint_id ){
-                                auto tmp = tag_value - typename FieldType::value_type(i);
-                                tmp *= FieldType::value_type::one() / (typename FieldType::value_type(constraint_id) - typename FieldType::value_type(i)); 
-                                result *= tmp;
+                                result *= tag_value - typename FieldType::value_type(i);
                             }
                         }
-                        result *= FieldType::value_type::one() / constraint_id;
-                        result *= table_id;
                         return result;
                     }
 
+                    static math::polynomial_dfs<typename FieldType::value_type> get_constraint_tag_from_gate_tag_column(
+                        const math::polynomial_dfs<typename FieldType::value_type> &tag_column,
+                        std::size_t constraints_num,
+                        std::size_t constraint_id,
+                        std::size_t table_id
+                    ){
+                        // The product has degree deg(tag) * constraints_num. The tag column is extended once
+                        // to a domain large enough for it and the product is evaluated point by point there.
+                        std::size_t degree = tag_column.degree() * std::max<std::size_t>(constraints_num, 1);
+                        std::size_t size = tag_column.size();
+                        while( size < degree + 1 ){
+                            size <<= 1;
+                        }
+
+                        math::polynomial_dfs<typename FieldType::value_type> extended_tag;
+                        const math::polynomial_dfs<typename FieldType::value_type> *tag = &tag_column;
+                        if( size != tag_column.size() ){
+                            extended_tag = tag_column;
+                            extended_tag.resize(size);
+                            tag = &extended_tag;
+                        }
+
+                        typename FieldType::value_type factor = get_constraint_tag_factor(constraints_num, constraint_id, table_id);
+                        math::polynomial_dfs<typename FieldType::value_type> result(degree, size);
+                        zk::detail::parallel_for(0, size, [&](std::size_t j) {
+                            result[j] = evaluate_constraint_tag((*tag)[j], factor, constraints_num, constraint_id);
+                        }, 4096);
+                        return result;
+                    }
+
+                    static typename FieldType::value_type get_constraint_tag_value_from_gate_tag_value(
+                        typename FieldType::value_type tag_value,
+                        std::size_t constraints_num,
+                        std::size_t constraint_id,
+                        std::size_t table_id
+                    ){
+                        return evaluate_constraint_tag(tag_value,
+                                                       get_constraint_tag_factor(constraints_num, constraint_id, table_id),
+                                                       constraints_num, constraint_id);
+                    }
+
                     struct prover_lookup_result {
                         std::array<math::polynomial_dfs<typename FieldType::value_type>, argument_size> F_dfs;
                         typename commitment_scheme_type::commitment_type lookup_commitment;
                     };
 
+                    /**
+                     * Numbers of occurrences of the table values in the table and input columns.
+                     * The cells are scattered into hash partitions, then each partition is counted into its own
+                     * hash map on the thread pool. Partitions are disjoint, so no locking is needed for counting
+                     * and the maps may be read concurrently afterwards.
+                     */
+                    class lookup_value_counts {
+                    public:
+                        using value_type = typename FieldType::value_type;
+
+                        lookup_value_counts(const std::vector<polynomial_dfs_type> &reduced_input,
+                                            const std::vector<polynomial_dfs_type> &reduced_value,
+                                            std::size_t usable_rows_amount)
+                            : _counts(partitions_num) {
+                            // Cells of reduced_value go first, then cells of reduced_input, column by column.
+                            std::size_t values_cells = reduced_value.size() * usable_rows_amount;
+                            std::size_t cells = values_cells + reduced_input.size() * usable_rows_amount;
+                            auto cell = [&](std::size_t id) -> const value_type & {
+                                if (id < values_cells) {
+                                    return reduced_value[id / usable_rows_amount][id % usable_rows_amount];
+                                }
+                                id -= values_cells;
+                                return reduced_input[id / usable_rows_amount][id % usable_rows_amount];
+                            };
+
+                            std::size_t pool_size = zk::detail::thread_pool::instance().size();
+                            std::size_t block_size = std::max<std::size_t>(4096, (cells + pool_size * 4 - 1) / (pool_size * 4));
+                            std::size_t blocks_num = (cells + block_size - 1) / block_size;
+
+                            std::vector<std::uint8_t> cell_partition(cells);
+                            std::vector<std::size_t> offsets(blocks_num * partitions_num, 0);
+                            zk::detail::parallel_for(0, blocks_num, [&](std::size_t block) {
+                                std::size_t *histogram = offsets.data() + block * partitions_num;
+                                for (std::size_t id = block * block_size; id < std::min(cells, (block + 1) * block_size); id++) {
+                                    cell_partition[id] = partition(cell(id));
+                                    histogram[cell_partition[id]]++;
+                                }
+                            });
+
+                            // Partition p of block b starts after all partitions < p and after partition p
+                            // of the blocks < b, so every partition keeps the cells order.
+                            std::vector<std::size_t> partition_begin(partitions_num + 1, 0);
+                            std::size_t total = 0;
+                            for (std::size_t p = 0; p < partitions_num; p++) {
+                                partition_begin[p] = total;
+                                for (std::size_t block = 0; block < blocks_num; block++) {
+                                    std::size_t count = offsets[block * partitions_num + p];
+                                    offsets[block * partitions_num + p] = total;
+                                    total += count;
+                                }
+                            }
+                            partition_begin[partitions_num] = total;
+
+                            std::vector<std::size_t> partitioned(cells);
+                            zk::detail::parallel_for(0, blocks_num, [&](std::size_t block) {
+                                std::size_t *offset = offsets.data() + block * partitions_num;
+                                for (std::size_t id = block * block_size; id < std::min(cells, (block + 1) * block_size); id++) {
+                                    partitioned[offset[cell_partition[id]]++] = id;
+                                }
+                            });
+
+                            zk::detail::parallel_for(0, partitions_num, [&](std::size_t p) {
+                                auto &counts = _counts[p];
+                                counts.reserve(partition_begin[p + 1] - partition_begin[p]);
+                                for (std::size_t k = partition_begin[p]; k < partition_begin[p + 1]; k++) {
+                                    std::size_t id = partitioned[k];
+                                    if (id < values_cells) {
+                                        counts[cell(id)]++;
+                                    } else {
+                                        // Every input value has to be one of the table values, they are counted first.
+                                        auto it = counts.find(cell(id));
+                                        BOOST_ASSERT(it != counts.end());
+                                        if (it != counts.end()) {
+                                            it->second++;
+                                        }
+                                    }
+                                }
+                            });
+                        }
+
+                        std::size_t count(const value_type &value) const {
+                            const auto &counts = _counts[partition(value)];
+                            auto it = counts.find(value);
+                            return it == counts.end() ? 0 : it->second;
+                        }
+
+                    private:
+                        static constexpr std::size_t partitions_bits = 6;
+                        static constexpr std::size_t partitions_num = std::size_t(1) << partitions_bits;
+
+                        static std::uint8_t partition(const value_type &value) {
+                            // Top bits of the Fibonacci hash, so that partitions do not depend on the low hash bits only.
+                            std::uint64_t hash = std::uint64_t(std::hash<value_type>()(value)) * 0x9E3779B97F4A7C15ull;
+                            return std::uint8_t(hash >> (64 - partitions_bits));
+                        }
+
+                        std::vector<std::unordered_map<value_type, std::size_t>> _counts;
+                    };
+
                     // Each lookup table should fill full rectangle inside assignment table
                     // Lookup tables may contain repeated values, but they shoul be placed into one
                     // option one under another. 
@@ -133,73 +277,53 @@ namespace nil {
                     // So similar values in compressed lookup tables vectors repeated values may be only in one column 
                     // near each other.
                     static inline std::vector<math::polynomial_dfs<typename FieldType::value_type>> sort_polynomials(
-                        const std::vector<math::polynomial_dfs<typename FieldType::value_type>> reduced_input,
-                        const std::vector<math::polynomial_dfs<typename FieldType::value_type>> reduced_value, 
+                        const std::vector<math::polynomial_dfs<typename FieldType::value_type>> &reduced_input,
+                        const std::vector<math::polynomial_dfs<typename FieldType::value_type>> &reduced_value,
                         std::size_t domain_size,
                         std::size_t usable_rows_amount
                         
                     ){
-                        //  Build sorting map
-                        std::map<typename FieldType::value_type, std::size_t> sorting_map;
+                        lookup_value_counts counts(reduced_input, reduced_value, usable_rows_amount);
+
+                        // Every run of equal table values is replaced by all the occurrences of the value.
+                        // Runs are found sequentially, they are written into the sorted columns in parallel.
+                        struct run_type {
+                            typename FieldType::value_type value;
+                            std::size_t count;
+                            std::size_t offset;
+                        };
+                        std::vector<run_type> runs;
+                        std::size_t total = 0;
+                        auto push_run = [&](const typename FieldType::value_type &value) {
+                            std::size_t count = (value == FieldType::value_type::zero()) ? 1 : counts.count(value);
+                            runs.push_back({value, count, total});
+                            total += count;
+                        };
+
+                        typename FieldType::value_type prev = FieldType::value_type::zero();
                         for( std::size_t i = 0; i < reduced_value.size(); i++){
                             for( std::size_t j = 0; j < usable_rows_amount; j++){
-                                if(sorting_map.find(reduced_value[i][j]) != sorting_map.end()) 
-                                    sorting_map[reduced_value[i][j]]++; 
-                                else 
-                                    sorting_map[reduced_value[i][j]] = 1;
+                                if(reduced_value[i][j] != prev){
+                                    push_run(prev);
+                                    prev = reduced_value[i][j];
+                                }
                             }
                         }
-                        for( std::size_t i = 0; i < reduced_input.size(); i++){
-                            for( std::size_t j = 0; j < usable_rows_amount; j++){
-                                // This assert means that every value \in keys of sorting_map = set of values of reduced_value
-                                BOOST_ASSERT(sorting_map.find(reduced_input[i][j]) != sorting_map.end());
-                                sorting_map[reduced_input[i][j]]++; 
-                            }
+                        if( prev != FieldType::value_type::zero() ){
+                            push_run(prev);
                         }
 
-
                         math::polynomial_dfs<typename FieldType::value_type> zero_poly(domain_size-1, domain_size, FieldType::value_type::zero());
                         std::vector<math::polynomial_dfs<typename FieldType::value_type>> sorted(
                             reduced_input.size() + reduced_value.size(), zero_poly
                         );
-                        std::size_t i1=0;
-                        std::size_t j1=0;
-                        typename FieldType::value_type prev(0);
-                        prev = typename FieldType::value_type(0);
-                        for( std::size_t i = 0; i < reduced_value.size(); i++){
-                            for( std::size_t j = 0; j < usable_rows_amount; j++){
-                                if(reduced_value[i][j] != prev){
-                                    if(prev == FieldType::value_type::zero()) {
-                                        BOOST_ASSERT(j1 < usable_rows_amount);
-                                        sorted[i1][j1] = prev;
-                                        j1++;
-                                        if(j1 >= usable_rows_amount){
-                                            i1++; j1 = 0;
-                                        } 
-                                    } else {
-                                        for( std::size_t k = 0; k < sorting_map[prev]; k++){
-                                            BOOST_ASSERT(j1 < usable_rows_amount);
-                                            sorted[i1][j1] = prev;
-                                            j1++;
-                                            if(j1 >= usable_rows_amount){
-                                                i1++; j1 = 0;
-                                            } 
-                                        }
-                                    }
-                                    prev = reduced_value[i][j];
-                                }
-                            }
-                        }
-                        if( prev != 0 ){
-                            for( std::size_t k = 0; k < sorting_map[prev]; k++){
-                                //BOOST_ASSERT(j1 < usable_rows_amount);
-                                sorted[i1][j1] = prev;
-                                j1++;
-                                if(j1 >= usable_rows_amount){
-                                    i1++; j1 = 0;
-                                } 
+                        BOOST_ASSERT(total <= sorted.size() * usable_rows_amount);
+
+                        zk::detail::parallel_for(0, runs.size(), [&](std::size_t r) {
+                            for( std::size_t k = runs[r].offset; k < runs[r].offset + runs[r].count; k++){
+                                sorted[k / usable_rows_amount][k % usable_rows_amount] = runs[r].value;
                             }
-                        }
+                        }, 256);
 
                         for( std::size_t i = 0; i < sorted.size()-1; i++){
                             sorted[i][usable_rows_amount] = sorted[i+1][0];
@@ -218,6 +342,25 @@ namespace nil {
                         commitment_scheme_type &commitment_scheme,
                         transcript_type &transcript = transcript_type()
                     ) {
+                        detail::placeholder_lde_cache<FieldType, ParamsType> lde_cache(
+                            plonk_columns, preprocessed_data.common_data.basic_domain);
+                        return prove_eval(constraint_system, preprocessed_data, plonk_columns, commitment_scheme,
+                                          transcript, lde_cache);
+                    }
+
+                    static inline prover_lookup_result prove_eval(
+                        const plonk_constraint_system<FieldType, typename ParamsType::arithmetization_params>
+                            &constraint_system,
+                        const typename placeholder_public_preprocessor<FieldType, ParamsType>::preprocessed_data_type
+                            &preprocessed_data,
+                        const plonk_polynomial_dfs_table<FieldType, typename ParamsType::arithmetization_params>
+                            &plonk_columns,
+                        commitment_scheme_type &commitment_scheme,
+                        transcript_type &transcript,
+                        detail::placeholder_lde_cache<FieldType, ParamsType> &lde_cache
+                    ) {
+                        BOOST_ASSERT(&lde_cache.table() == &plonk_columns);
+
                         // Copied from gate argument.
                         // TODO: remove code duplication.
                         auto value_type_to_polynomial_dfs = [&assignments=plonk_columns](
@@ -231,36 +374,10 @@ namespace nil {
                         std::shared_ptr<math::evaluation_domain<FieldType>> basic_domain =
                             preprocessed_data.common_data.basic_domain;
 
-                        auto get_var_value = [&domain=basic_domain, &assignments=plonk_columns]
-                        (const DfsVariableType &var) {
-                            polynomial_dfs_type assignment;
-                            switch (var.type) {
-                                case DfsVariableType::column_type::witness:
-                                    assignment = assignments.witness(var.index);
-                                    break;
-                                case DfsVariableType::column_type::public_input:
-                                    assignment = assignments.public_input(var.index);
-                                    break;
-                                case DfsVariableType::column_type::constant:
-                                    assignment = assignments.constant(var.index);
-                                    break;
-                                case DfsVariableType::column_type::selector:
-                                    assignment = assignments.selector(var.index);
-                                    break;
-                            }
-
-                            if (var.rotation != 0) {
-                                assignment = math::polynomial_shift(assignment, var.rotation, domain->m);
-                            }
-                            return assignment;
-                        };
-
-
                         prover_lookup_result result;
 
                         // $/theta = \challenge$
                         typename FieldType::value_type theta = transcript.template challenge<FieldType>();
-                        typename FieldType::value_type theta_acc;
                         
                         // Construct lookup gates
                         const std::vector<plonk_lookup_gate<FieldType, plonk_lookup_constraint<FieldType>>> &lookup_gates =
@@ -277,52 +394,71 @@ namespace nil {
                             one_polynomial -  preprocessed_data.q_last - preprocessed_data.q_blind;
 
                         // Prepare lookup value
-                        std::vector<math::polynomial_dfs<typename FieldType::value_type>> lookup_value;
+                        // Every (table, option) pair and every lookup constraint gives an independent column.
+                        std::vector<std::pair<std::size_t, std::size_t>> lookup_value_ids;
                         for(std::size_t t_id = 0; t_id < lookup_tables.size(); t_id++){
+                            for( std::size_t o_id = 0; o_id < lookup_tables[t_id].lookup_options.size(); o_id++ ){
+                                lookup_value_ids.emplace_back(t_id, o_id);
+                            }
+                        }
+                        std::vector<math::polynomial_dfs<typename FieldType::value_type>> lookup_value(lookup_value_ids.size());
+                        zk::detail::parallel_for(0, lookup_value_ids.size(), [&](std::size_t value_id) {
+                            auto [t_id, o_id] = lookup_value_ids[value_id];
                             const plonk_lookup_table<FieldType> &l_table = lookup_tables[t_id];
                             const math::polynomial_dfs<typename FieldType::value_type> &lookup_tag = plonk_columns.selector(l_table.tag_index);
-                            for( std::size_t o_id = 0; o_id < l_table.lookup_options.size(); o_id++ ){
-                                math::polynomial_dfs<typename FieldType::value_type> v = (typename FieldType::value_type(t_id + 1)) * lookup_tag;
-                                theta_acc = theta;
-                                for(std::size_t i = 0; i < l_table.columns_number; i++){
-                                    v += theta_acc * lookup_tag * plonk_columns.constant(l_table.lookup_options[o_id][i].index);
-                                    theta_acc *= theta;
-                                }
-                                v *= mask_assignment;
-                                auto reduced_v = reduce_dfs_polynomial_domain(v, basic_domain->m);
-                                lookup_value.push_back(v);
+                            math::polynomial_dfs<typename FieldType::value_type> v = (typename FieldType::value_type(t_id + 1)) * lookup_tag;
+                            typename FieldType::value_type theta_acc = theta;
+                            for(std::size_t i = 0; i < l_table.columns_number; i++){
+                                v += theta_acc * lookup_tag * plonk_columns.constant(l_table.lookup_options[o_id][i].index);
+                                theta_acc *= theta;
                             }
-                        }
-
-                        // Prepare lookup input                        
-                        std::vector<math::polynomial_dfs<typename FieldType::value_type>> lookup_input;
-                        for( const auto &gate:lookup_gates ){
-                            math::expression<DfsVariableType> expr; 
-                            math::polynomial_dfs<typename FieldType::value_type> lookup_selector = plonk_columns.selector(gate.tag_index);
-                            for( const auto &constraint: gate.constraints ){
-                                math::polynomial_dfs<typename FieldType::value_type> l = lookup_selector * (typename FieldType::value_type(constraint.table_id));
-                                theta_acc = theta;
-                                for( std::size_t k = 0; k < constraint.lookup_input.size(); k++){
-                                    expr = converter.convert(constraint.lookup_input[k]);
-                                    math::cached_expression_evaluator<DfsVariableType> evaluator(expr, get_var_value);
+                            v *= mask_assignment;
+                            lookup_value[value_id] = std::move(v);
+                        });
 
-                                    l += theta_acc * lookup_selector * evaluator.evaluate();
-                                    theta_acc *= theta;
-                                }
-                               lookup_input.push_back(l);
+                        // Prepare lookup input
+                        std::vector<std::pair<std::size_t, std::size_t>> lookup_input_ids;
+                        for( std::size_t g_id = 0; g_id < lookup_gates.size(); g_id++ ){
+                            for( std::size_t c_id = 0; c_id < lookup_gates[g_id].constraints.size(); c_id++ ){
+                                lookup_input_ids.emplace_back(g_id, c_id);
                             }
                         }
+                        std::vector<math::polynomial_dfs<typename FieldType::value_type>> lookup_input(lookup_input_ids.size());
+                        zk::detail::parallel_for(0, lookup_input_ids.size(), [&](std::size_t input_id) {
+                            auto [g_id, c_id] = lookup_input_ids[input_id];
+                            const auto &gate = lookup_gates[g_id];
+                            const auto &constraint = gate.constraints[c_id];
+                            const math::polynomial_dfs<typename FieldType::value_type> &lookup_selector = plonk_columns.selector(gate.tag_index);
+                            math::polynomial_dfs<typename FieldType::value_type> l = lookup_selector * (typename FieldType::value_type(constraint.table_id));
+                            typename FieldType::value_type theta_acc = theta;
+                            for( std::size_t k = 0; k < constraint.lookup_input.size(); k++){
+                                math::expression<DfsVariableType> expr = converter.convert(constraint.lookup_input[k]);
+                                math::compiled_expression<DfsVariableType> program =
+                                    math::expression_compiler<DfsVariableType>::compile(expr);
+
+                                // Rotated columns are read in place by index offsets.
+                                std::vector<detail::dfs_column_view<FieldType>> inputs;
+                                inputs.reserve(program.variables().size());
+                                for (const auto &var : program.variables()) {
+                                    inputs.push_back(lde_cache.get_view(var, basic_domain->m));
+                                }
+
+                                l += theta_acc * lookup_selector * detail::evaluate_dfs_program<FieldType>(program, inputs);
+                                theta_acc *= theta;
+                            }
+                            lookup_input[input_id] = std::move(l);
+                        });
                         // 3. Lookup_input and lookup_value are ready
                         //    Now sort them!
                         //    Reduce value and input:
-                        std::vector<math::polynomial_dfs<typename FieldType::value_type>> reduced_value;
-                        for( std::size_t i = 0; i < lookup_value.size(); i++ ){
-                            reduced_value.push_back(reduce_dfs_polynomial_domain(lookup_value[i], basic_domain->m));
-                        }
-                        std::vector<math::polynomial_dfs<typename FieldType::value_type>> reduced_input;
-                        for( std::size_t i = 0; i < lookup_input.size(); i++ ){
-                            reduced_input.push_back(reduce_dfs_polynomial_domain(lookup_input[i], basic_domain->m));
-                        }
+                        std::vector<math::polynomial_dfs<typename FieldType::value_type>> reduced_value(lookup_value.size());
+                        zk::detail::parallel_for(0, lookup_value.size(), [&](std::size_t i) {
+                            reduced_value[i] = reduce_dfs_polynomial_domain(lookup_value[i], basic_domain->m);
+                        });
+                        std::vector<math::polynomial_dfs<typename FieldType::value_type>> reduced_input(lookup_input.size());
+                        zk::detail::parallel_for(0, lookup_input.size(), [&](std::size_t i) {
+                            reduced_input[i] = reduce_dfs_polynomial_domain(lookup_input[i], basic_domain->m);
+                        });
                         //    Sort
                         auto sorted = sort_polynomials(reduced_input, reduced_value, basic_domain->m, preprocessed_data.common_data.usable_rows_amount);
 
@@ -341,23 +477,26 @@ namespace nil {
                         V_L[0] = FieldType::value_type::one();
                         auto one = FieldType::value_type::one();
 
-                        for (std::size_t k = 1; k <= preprocessed_data.common_data.usable_rows_amount; k++) {
-                            V_L[k] = V_L[k-1];
-                            typename FieldType::value_type g_tmp(1);
+                        // Row factors are independent, the running product is built by the grand product kernel.
+                        std::size_t usable_rows_amount = preprocessed_data.common_data.usable_rows_amount;
+                        std::vector<typename FieldType::value_type> g_tmp(usable_rows_amount + 1);
+                        std::vector<typename FieldType::value_type> h_tmp(usable_rows_amount + 1);
+                        zk::detail::parallel_for(1, usable_rows_amount + 1, [&](std::size_t k) {
+                            g_tmp[k] = one;
                             for( std::size_t i = 0; i < reduced_input.size(); i++){
-                                g_tmp *= (one+beta)*(gamma + reduced_input[i][k-1]);
+                                g_tmp[k] *= (one+beta)*(gamma + reduced_input[i][k-1]);
                             }
                             for( std::size_t i = 0; i < reduced_value.size(); i++){
-                                g_tmp *= (one+beta)*gamma + reduced_value[i][k-1] + beta * reduced_value[i][k];
+                                g_tmp[k] *= (one+beta)*gamma + reduced_value[i][k-1] + beta * reduced_value[i][k];
                             }
-                            V_L[k] *= g_tmp;
 
-                            typename FieldType::value_type h_tmp(1);
+                            h_tmp[k] = one;
                             for( std::size_t i = 0; i < sorted.size(); i++){
-                                h_tmp *= ((one+beta)*gamma + sorted[i][k-1] + beta * sorted[i][k]);
+                                h_tmp[k] *= ((one+beta)*gamma + sorted[i][k-1] + beta * sorted[i][k]);
                             }
-                            V_L[k] *= h_tmp.inversed();
-                        }
+                        }, 256);
+
+                        zk::detail::grand_product(g_tmp, h_tmp, V_L);
                         commitment_scheme.append_to_batch(PERMUTATION_BATCH, V_L);
 
                         BOOST_CHECK(V_L[preprocessed_data.common_data.usable_rows_amount] ==  FieldType::value_type::one());
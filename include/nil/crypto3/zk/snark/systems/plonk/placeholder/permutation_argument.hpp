@@ -39,6 +39,8 @@
 
 #include <nil/crypto3/container/merkle/tree.hpp>
 
+#include <nil/crypto3/zk/detail/grand_product.hpp>
+#include <nil/crypto3/zk/detail/parallelization.hpp>
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/params.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_policy.hpp>
@@ -72,9 +74,12 @@ namespace nil {
                     {
                         std::size_t stride = 1;
                         while (stride < multipliers.size() ) {
-                            for(std::size_t i = 0; i + stride < multipliers.size(); i += stride*2) {
+                            // Products inside one level are independent.
+                            std::size_t pairs_num = (multipliers.size() - stride + 2 * stride - 1) / (2 * stride);
+                            zk::detail::parallel_for(0, pairs_num, [&multipliers, stride](std::size_t pair) {
+                                std::size_t i = pair * stride * 2;
                                 multipliers[i] *= multipliers[ i + stride ];
-                            }
+                            });
                             stride *= 2;
                         }
                         return multipliers[0];
@@ -84,7 +89,7 @@ namespace nil {
                         const plonk_constraint_system<FieldType, typename ParamsType::arithmetization_params>
                             &constraint_system,
                         const typename placeholder_public_preprocessor<FieldType, ParamsType>::preprocessed_data_type
-                            preprocessed_data,
+                            &preprocessed_data,
                         const plonk_table_description<FieldType, typename ParamsType::arithmetization_params>
                             &table_description,
                         const plonk_polynomial_dfs_table<FieldType, typename ParamsType::arithmetization_params>
@@ -111,7 +116,7 @@ namespace nil {
 
                         std::vector<math::polynomial_dfs<typename FieldType::value_type>> g_v = S_id;
                         std::vector<math::polynomial_dfs<typename FieldType::value_type>> h_v = S_sigma;
-                        for (std::size_t i = 0; i < S_id.size(); i++) {
+                        zk::detail::parallel_for(0, S_id.size(), [&](std::size_t i) {
                             BOOST_ASSERT(column_polynomials[i].size() == basic_domain->size());
                             BOOST_ASSERT(S_id[i].size() == basic_domain->size());
                             BOOST_ASSERT(S_sigma[i].size() == basic_domain->size());
@@ -125,27 +130,34 @@ namespace nil {
                             h_v[i] *= beta;
                             h_v[i] += gamma;
                             h_v[i] += column_polynomials[i];
-                        }
+                        });
 
-                        V_P[0] = FieldType::value_type::one();
-                        for (std::size_t j = 1; j < basic_domain->size(); j++) {
-                            typename FieldType::value_type nom = FieldType::value_type::one();
-                            typename FieldType::value_type denom = FieldType::value_type::one();
+                        // Row products are independent, the running product is built by the grand product kernel.
+                        std::vector<typename FieldType::value_type> nom(basic_domain->size());
+                        std::vector<typename FieldType::value_type> denom(basic_domain->size());
+                        zk::detail::parallel_for(1, basic_domain->size(), [&](std::size_t j) {
+                            nom[j] = FieldType::value_type::one();
+                            denom[j] = FieldType::value_type::one();
 
                             for (std::size_t i = 0; i < S_id.size(); i++) {
-                                nom *= g_v[i][j - 1];
-                                denom *= h_v[i][j - 1];
+                                nom[j] *= g_v[i][j - 1];
+                                denom[j] *= h_v[i][j - 1];
                             }
-                            V_P[j] = V_P[j - 1] * nom / denom;
-                        }
+                        }, 256);
+
+                        zk::detail::grand_product(nom, denom, V_P);
 
                         // 4. Compute and add commitment to $V_P$ to $\text{transcript}$.
                         // TODO: Better enumeration for polynomial batches
                         commitment_scheme.append_to_batch(PERMUTATION_BATCH, V_P);
 
                         // 5. Calculate g_perm, h_perm
-                        math::polynomial_dfs<typename FieldType::value_type> g = polynomial_product(std::move(g_v));
-                        math::polynomial_dfs<typename FieldType::value_type> h = polynomial_product(std::move(h_v));
+                        math::polynomial_dfs<typename FieldType::value_type> g;
+                        math::polynomial_dfs<typename FieldType::value_type> h;
+                        zk::detail::parallel_invoke({
+                            [&]() { g = polynomial_product(std::move(g_v)); },
+                            [&]() { h = polynomial_product(std::move(h_v)); }
+                        });
 
                         math::polynomial_dfs<typename FieldType::value_type> one_polynomial(
                             0, V_P.size(), FieldType::value_type::one());
@@ -153,28 +165,33 @@ namespace nil {
                         math::polynomial_dfs<typename FieldType::value_type> V_P_shifted =
                             math::polynomial_shift(V_P, 1, basic_domain->m);
 
-                        /* F_dfs[0] = preprocessed_data.common_data.lagrange_0 * (one_polynomial - V_P); */
-
-                        F_dfs[0] = one_polynomial;
-                        F_dfs[0] -= V_P;
-                        F_dfs[0] *= preprocessed_data.common_data.lagrange_0;
-
-                        /* F_dfs[1] = (one_polynomial - (preprocessed_data.q_last + preprocessed_data.q_blind)) * (V_P_shifted * h - V_P * g); */
-                        math::polynomial_dfs<typename FieldType::value_type> t1 = V_P;
-                        t1 *= g;
-                        V_P_shifted *= h;
-                        V_P_shifted -= t1;
-
-                        F_dfs[1] = one_polynomial;
-                        F_dfs[1] -= preprocessed_data.q_last;
-                        F_dfs[1] -= preprocessed_data.q_blind;
-                        F_dfs[1] *= V_P_shifted;
-
-                        /* F_dfs[2] = preprocessed_data.q_last * V_P * (V_P - one_polynomial); */
-                        F_dfs[2] = V_P;
-                        F_dfs[2] -= one_polynomial;
-                        F_dfs[2] *= V_P;
-                        F_dfs[2] *= preprocessed_data.q_last;
+                        zk::detail::parallel_invoke({
+                            [&]() {
+                                /* F_dfs[0] = preprocessed_data.common_data.lagrange_0 * (one_polynomial - V_P); */
+                                F_dfs[0] = one_polynomial;
+                                F_dfs[0] -= V_P;
+                                F_dfs[0] *= preprocessed_data.common_data.lagrange_0;
+                            },
+                            [&]() {
+                                /* F_dfs[1] = (one_polynomial - (preprocessed_data.q_last + preprocessed_data.q_blind)) * (V_P_shifted * h - V_P * g); */
+                                math::polynomial_dfs<typename FieldType::value_type> t1 = V_P;
+                                t1 *= g;
+                                V_P_shifted *= h;
+                                V_P_shifted -= t1;
+
+                                F_dfs[1] = one_polynomial;
+                                F_dfs[1] -= preprocessed_data.q_last;
+                                F_dfs[1] -= preprocessed_data.q_blind;
+                                F_dfs[1] *= V_P_shifted;
+                            },
+                            [&]() {
+                                /* F_dfs[2] = preprocessed_data.q_last * V_P * (V_P - one_polynomial); */
+                                F_dfs[2] = V_P;
+                                F_dfs[2] -= one_polynomial;
+                                F_dfs[2] *= V_P;
+                                F_dfs[2] *= preprocessed_data.q_last;
+                            }
+                        });
 
                         prover_result_type res = {std::move(F_dfs), std::move(V_P)};
 
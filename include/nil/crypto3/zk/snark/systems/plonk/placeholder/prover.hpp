@@ -32,9 +32,13 @@
 #include <set>
 
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
+#include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
+
+#include <nil/crypto3/algebra/fields/params.hpp>
 
 #include <nil/crypto3/container/merkle/tree.hpp>
 
+#include <nil/crypto3/zk/detail/parallelization.hpp>
 #include <nil/crypto3/zk/commitments/polynomial/lpc.hpp>
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/constraint.hpp>
@@ -69,6 +73,12 @@ namespace nil {
                     }
                 }    // namespace detail
 
+                /**
+                 * Prover stages run their independent per-column and per-chunk work on
+                 * zk::detail::thread_pool::instance(). The pool is single-threaded by default, call
+                 * thread_pool::instance().resize(threads_num) before proving to enable the multithreaded mode.
+                 * The proof does not depend on the number of threads.
+                 */
                 template<typename FieldType, typename ParamsType>
                 class placeholder_prover {
                     constexpr static const std::size_t witness_columns = ParamsType::witness_columns;
@@ -129,6 +139,7 @@ namespace nil {
                             , _commitment_scheme(commitment_scheme)
                             , _polynomial_table(preprocessed_private_data.private_polynomial_table,
                                                 preprocessed_public_data.public_polynomial_table)
+                            , _lde_cache(_polynomial_table, preprocessed_public_data.common_data.basic_domain)
                             , _is_lookup_enabled(constraint_system.lookup_gates().size() > 0)
                             , transcript(std::vector<std::uint8_t>())
                     {
@@ -189,8 +200,10 @@ namespace nil {
                             preprocessed_public_data.common_data.basic_domain,
                             preprocessed_public_data.common_data.max_gates_degree,
                             mask_polynomial,
-                            transcript
+                            transcript,
+                            _lde_cache
                         )[0];
+                        _lde_cache.clear();
 
                         /////TEST
 #ifdef ZK_PLACEHOLDER_DEBUG_ENABLED
@@ -219,16 +232,19 @@ namespace nil {
                 private:
                     std::vector<polynomial_dfs_type> quotient_polynomial_split_dfs() {
                         // TODO: pass max_degree parameter placeholder
-                        std::vector<polynomial_type> T_splitted = detail::split_polynomial<FieldType>(
-                            quotient_polynomial(), table_description.rows_amount - 1
-                        );
+                        const polynomial_type T_consolidated = quotient_polynomial();
+                        const std::size_t chunk_size = table_description.rows_amount;
+                        const std::size_t parts = (T_consolidated.size() - 1) / chunk_size + 1;
 
                         PROFILE_PLACEHOLDER_SCOPE("split_polynomial_dfs_conversion_time");
 
-                        std::vector<polynomial_dfs_type> T_splitted_dfs(T_splitted.size());
-                        for (std::size_t k = 0; k < T_splitted.size(); k++) {
-                            T_splitted_dfs[k].from_coefficients(T_splitted[k]);
-                        }
+                        // Chunks are taken straight from the quotient coefficients, same as split_polynomial.
+                        std::vector<polynomial_dfs_type> T_splitted_dfs(parts);
+                        zk::detail::parallel_for(0, parts, [&T_consolidated, &T_splitted_dfs, chunk_size](std::size_t k) {
+                            auto first = T_consolidated.begin() + k * chunk_size;
+                            auto last = T_consolidated.begin() + std::min(T_consolidated.size(), (k + 1) * chunk_size);
+                            T_splitted_dfs[k].from_coefficients(polynomial_type(first, last));
+                        });
 
                         return T_splitted_dfs;
                     }
@@ -250,12 +266,74 @@ namespace nil {
                             F_consolidated_dfs += alphas[i] * _F_dfs[i];
                         }
 
-                        polynomial_type F_consolidated_normal(F_consolidated_dfs.coefficients());
+                        return divide_by_vanishing_polynomial_on_coset(F_consolidated_dfs);
+                    }
+
+                    /**
+                     * Computes F / Z_H for F given by its evaluations on the extended domain.
+                     * Z_H = x^n - 1 vanishes on a part of the extended domain, so F is moved to the coset
+                     * g * D_ext, where Z_H(g * w^i) = g^n * (w^n)^i - 1 takes only N / n distinct values.
+                     * The division becomes a pointwise multiplication by a few precomputed inverses, and
+                     * one inverse FFT on the coset yields the coefficients of the quotient.
+                     */
+                    polynomial_type divide_by_vanishing_polynomial_on_coset(const polynomial_dfs_type &F_dfs) {
+                        PROFILE_PLACEHOLDER_SCOPE("quotient_coset_division_time");
+
+                        const std::size_t rows_amount = preprocessed_public_data.common_data.basic_domain->m;
+                        const std::size_t extended_size = F_dfs.size();
+                        BOOST_ASSERT(extended_size % rows_amount == 0);
+                        const std::size_t blowup = extended_size / rows_amount;
+
+                        std::shared_ptr<math::evaluation_domain<FieldType>> extended_domain =
+                            math::make_evaluation_domain<FieldType>(extended_size);
+
+                        const typename FieldType::value_type g =
+                            algebra::fields::arithmetic_params<FieldType>::multiplicative_generator;
+
+                        std::vector<typename FieldType::value_type> values(F_dfs.begin(), F_dfs.end());
+                        extended_domain->inverse_fft(values);
+                        multiply_by_coset_powers(values, g);
+                        extended_domain->fft(values);
+
+                        // Z_H(g * w^i) depends only on i mod blowup.
+                        std::vector<typename FieldType::value_type> Z_inversed(blowup);
+                        const typename FieldType::value_type g_pow_n = g.pow(rows_amount);
+                        const typename FieldType::value_type w_pow_n =
+                            extended_domain->get_domain_element(rows_amount);
+                        typename FieldType::value_type w_acc = FieldType::value_type::one();
+                        for (std::size_t i = 0; i < blowup; i++) {
+                            Z_inversed[i] = (g_pow_n * w_acc - FieldType::value_type::one()).inversed();
+                            w_acc *= w_pow_n;
+                        }
+
+                        zk::detail::parallel_for(0, extended_size, [&values, &Z_inversed, blowup](std::size_t i) {
+                            values[i] *= Z_inversed[i % blowup];
+                        }, 1024);
+
+                        extended_domain->inverse_fft(values);
+                        multiply_by_coset_powers(values, g.inversed());
+
+                        // Drop the zero high coefficients, deg(T) = deg(F) - n.
+                        std::size_t T_size = values.size();
+                        while (T_size > 1 && values[T_size - 1] == FieldType::value_type::zero()) {
+                            T_size--;
+                        }
+                        values.resize(T_size);
 
-                        polynomial_type T_consolidated =
-                            F_consolidated_normal / preprocessed_public_data.common_data.Z;
+                        return polynomial_type(std::move(values));
+                    }
 
-                        return T_consolidated;
+                    static void multiply_by_coset_powers(
+                            std::vector<typename FieldType::value_type> &coefficients,
+                            const typename FieldType::value_type &shift) {
+                        zk::detail::parallel_for_chunks(0, coefficients.size(),
+                            [&coefficients, &shift](std::size_t begin, std::size_t end) {
+                                typename FieldType::value_type acc = shift.pow(begin);
+                                for (std::size_t i = begin; i < end; i++) {
+                                    coefficients[i] *= acc;
+                                    acc *= shift;
+                                }
+                            }, 1024);
                     }
 
                     typename placeholder_lookup_argument<FieldType, commitment_scheme_type, ParamsType>::prover_lookup_result
@@ -276,7 +354,8 @@ namespace nil {
                                 preprocessed_public_data,
                                 _polynomial_table,
                                 _commitment_scheme,
-                                transcript
+                                transcript,
+                                _lde_cache
                             );
                             _proof.commitments[LOOKUP_BATCH] = lookup_argument_result.lookup_commitment;
                         }
@@ -425,6 +504,8 @@ namespace nil {
 
                     // Members created during proof generation.
                     plonk_polynomial_dfs_table<FieldType, typename ParamsType::arithmetization_params> _polynomial_table;
+                    // Shifted and extended columns shared by the lookup and gate arguments.
+                    detail::placeholder_lde_cache<FieldType, ParamsType> _lde_cache;
                     placeholder_proof<FieldType, ParamsType> _proof;
                     std::array<polynomial_dfs_type, f_parts> _F_dfs;
                     transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript;
@@ -139,6 +139,24 @@ namespace nil {
                         return Prover::process(pk, primary_input, auxiliary_input);
                     }
 
+                    // Same proof with the fixed-base tables of the proving key.
+                    static inline proof_type
+                        prove(const r1cs_gg_ppzksnark_preprocessed_proving_key<proving_key_type> &preprocessed_pk,
+                              const primary_input_type &primary_input,
+                              const auxiliary_input_type &auxiliary_input) {
+
+                        return Prover::process(preprocessed_pk, primary_input, auxiliary_input);
+                    }
+
+                    // Proofs for all the (primary_inputs[i], auxiliary_inputs[i]) with one traversal of the key.
+                    static inline std::vector<proof_type>
+                        prove_batch(const proving_key_type &pk,
+                                    const std::vector<primary_input_type> &primary_inputs,
+                                    const std::vector<auxiliary_input_type> &auxiliary_inputs) {
+
+                        return Prover::process_batch(pk, primary_inputs, auxiliary_inputs);
+                    }
+
                     template<typename VerificationKey>
                     static inline bool verify(const VerificationKey &vk,
                                               const primary_input_type &primary_input,
@@ -0,0 +1,241 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_R1CS_GG_PPZKSNARK_FIXED_BASE_MULTIEXP_HPP
+#define CRYPTO3_R1CS_GG_PPZKSNARK_FIXED_BASE_MULTIEXP_HPP
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <nil/crypto3/multiprecision/number.hpp>
+#include <nil/crypto3/multiprecision/cpp_int.hpp>
+
+#include <nil/crypto3/zk/detail/parallelization.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace snark {
+                namespace detail {
+
+                    // Bases of a prover multiexp part, small enough for a part to stay in cache across the inputs
+                    // of a batch. Tables choose their default window for parts of this size.
+                    constexpr std::size_t multiexp_max_part_size = 1 << 14;
+
+                    /**
+                     * Precomputed multiples of fixed bases for multiexps over them.
+                     *
+                     * Scalars are split into W windows of window_bits bits. For every base P the table keeps
+                     * 2^(k * stride * window_bits) * P for k < ceil(W / stride). A multiexp is then stride bucket
+                     * passes over all the kept points, one for every window offset, with window_bits doublings
+                     * between the passes, instead of W passes and a doubling per scalar bit.
+                     * stride = 1 is the fastest and keeps W points per base, a larger stride keeps fewer points.
+                     */
+                    template<typename GroupType, typename ScalarFieldType>
+                    class fixed_base_table {
+                    public:
+                        typedef typename GroupType::value_type group_value_type;
+                        typedef typename ScalarFieldType::value_type scalar_value_type;
+
+                        constexpr static const std::size_t scalar_bits = ScalarFieldType::modulus_bits;
+                        constexpr static const std::size_t max_window_bits = 20;
+
+                        fixed_base_table() : _window_bits(1), _stride(1), _bases_num(0) {
+                        }
+
+                        template<typename InputIterator>
+                        fixed_base_table(InputIterator first, InputIterator last, std::size_t window_bits,
+                                         std::size_t stride) :
+                            _window_bits(window_bits),
+                            _stride(stride), _bases_num(std::distance(first, last)) {
+                            check_parameters();
+
+                            const std::size_t points_num = points_per_base();
+                            _points.resize(_bases_num * points_num);
+                            std::vector<group_value_type> bases(first, last);
+                            zk::detail::parallel_for(0, _bases_num, [this, &bases, points_num](std::size_t i) {
+                                group_value_type point = bases[i];
+                                for (std::size_t k = 0; k < points_num; k++) {
+                                    _points[i * points_num + k] = point;
+                                    for (std::size_t t = 0; t < _stride * _window_bits && k + 1 < points_num; t++) {
+                                        point = point.doubled();
+                                    }
+                                }
+                            });
+                        }
+
+                        // A table read back from its points, as returned by points().
+                        fixed_base_table(std::size_t window_bits, std::size_t stride, std::size_t bases_num,
+                                         std::vector<group_value_type> &&points) :
+                            _window_bits(window_bits),
+                            _stride(stride), _bases_num(bases_num), _points(std::move(points)) {
+                            check_parameters();
+                            if (_points.size() != _bases_num * points_per_base()) {
+                                throw std::invalid_argument("fixed_base_table: wrong number of points");
+                            }
+                        }
+
+                        std::size_t window_bits() const {
+                            return _window_bits;
+                        }
+
+                        std::size_t stride() const {
+                            return _stride;
+                        }
+
+                        std::size_t bases_num() const {
+                            return _bases_num;
+                        }
+
+                        std::size_t windows_num() const {
+                            return (scalar_bits + _window_bits - 1) / _window_bits;
+                        }
+
+                        std::size_t points_per_base() const {
+                            return (windows_num() + _stride - 1) / _stride;
+                        }
+
+                        /**
+                         * Window with the fewest group additions for a multiexp of scalars_num scalars with stride 1:
+                         * one bucket addition per window of every scalar and 2^(window_bits + 1) to sum the buckets.
+                         * Ties go to the larger window, which keeps fewer points.
+                         */
+                        static std::size_t optimal_window_bits(std::size_t scalars_num) {
+                            std::size_t best_window_bits = 1;
+                            std::size_t best_cost = std::numeric_limits<std::size_t>::max();
+                            for (std::size_t window_bits = 1; window_bits <= max_window_bits; window_bits++) {
+                                std::size_t cost = scalars_num * ((scalar_bits + window_bits - 1) / window_bits) +
+                                                   (std::size_t(2) << window_bits);
+                                if (cost <= best_cost) {
+                                    best_cost = cost;
+                                    best_window_bits = window_bits;
+                                }
+                            }
+                            return best_window_bits;
+                        }
+
+                        // Base number i is points()[i * points_per_base()].
+                        const std::vector<group_value_type> &points() const {
+                            return _points;
+                        }
+
+                        // sum_j scalar_j * base_(first_base + j) for the scalars in [scalar_first, scalar_last).
+                        template<typename ScalarIterator>
+                        group_value_type multiexp(std::size_t first_base, ScalarIterator scalar_first,
+                                                  ScalarIterator scalar_last) const {
+                            typedef typename ScalarFieldType::integral_type integral_type;
+
+                            const std::size_t scalars_num = std::distance(scalar_first, scalar_last);
+                            BOOST_ASSERT(first_base + scalars_num <= _bases_num);
+
+                            const std::size_t windows = windows_num();
+                            const std::size_t points_num = points_per_base();
+
+                            // A window spans at most two limbs, as max_window_bits is below the limb size.
+                            std::vector<std::uint32_t> digits(scalars_num * windows, 0);
+                            const std::uint64_t digit_mask = (std::uint64_t(1) << _window_bits) - 1;
+                            std::size_t j = 0;
+                            for (ScalarIterator it = scalar_first; it != scalar_last; ++it, ++j) {
+                                integral_type scalar = integral_type(it->data);
+                                const auto *limbs = scalar.backend().limbs();
+                                const std::size_t limbs_num = scalar.backend().size();
+                                constexpr std::size_t limb_bits = 8 * sizeof(*limbs);
+                                static_assert(limb_bits >= 32, "fixed_base_table: windows span more than two limbs");
+                                for (std::size_t window = 0; window < windows; window++) {
+                                    std::size_t limb = window * _window_bits / limb_bits;
+                                    std::size_t shift = window * _window_bits % limb_bits;
+                                    if (limb >= limbs_num) {
+                                        break;
+                                    }
+                                    std::uint64_t digit = std::uint64_t(limbs[limb]) >> shift;
+                                    if (shift + _window_bits > limb_bits && limb + 1 < limbs_num) {
+                                        digit |= std::uint64_t(limbs[limb + 1]) << (limb_bits - shift);
+                                    }
+                                    digits[j * windows + window] = std::uint32_t(digit & digit_mask);
+                                }
+                            }
+
+                            group_value_type result = group_value_type::zero();
+                            std::vector<group_value_type> buckets((std::size_t(1) << _window_bits) - 1);
+                            for (std::size_t offset = _stride; offset-- > 0;) {
+                                for (std::size_t t = 0; t < _window_bits; t++) {
+                                    result = result.doubled();
+                                }
+
+                                std::fill(buckets.begin(), buckets.end(), group_value_type::zero());
+                                for (j = 0; j < scalars_num; j++) {
+                                    const group_value_type *points = &_points[(first_base + j) * points_num];
+                                    for (std::size_t k = 0; k < points_num; k++) {
+                                        std::size_t window = k * _stride + offset;
+                                        if (window >= windows) {
+                                            break;
+                                        }
+                                        std::uint32_t digit = digits[j * windows + window];
+                                        if (digit != 0) {
+                                            buckets[digit - 1] = buckets[digit - 1] + points[k];
+                                        }
+                                    }
+                                }
+
+                                // sum_d d * bucket_d
+                                group_value_type running = group_value_type::zero();
+                                group_value_type sum = group_value_type::zero();
+                                for (std::size_t d = buckets.size(); d > 0; d--) {
+                                    running = running + buckets[d - 1];
+                                    sum = sum + running;
+                                }
+                                result = result + sum;
+                            }
+                            return result;
+                        }
+
+                        bool operator==(const fixed_base_table &other) const {
+                            return _window_bits == other._window_bits && _stride == other._stride &&
+                                   _bases_num == other._bases_num && _points == other._points;
+                        }
+
+                    private:
+                        void check_parameters() const {
+                            if (_window_bits == 0 || _window_bits > max_window_bits || _stride == 0) {
+                                throw std::invalid_argument("fixed_base_table: wrong window parameters");
+                            }
+                        }
+
+                        std::size_t _window_bits;
+                        std::size_t _stride;
+                        std::size_t _bases_num;
+                        std::vector<group_value_type> _points;
+                    };
+                }    // namespace detail
+            }        // namespace snark
+        }            // namespace zk
+    }                // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_R1CS_GG_PPZKSNARK_FIXED_BASE_MULTIEXP_HPP
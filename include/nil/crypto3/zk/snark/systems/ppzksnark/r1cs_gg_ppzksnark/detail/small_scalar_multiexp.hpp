@@ -0,0 +1,183 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_R1CS_GG_PPZKSNARK_SMALL_SCALAR_MULTIEXP_HPP
+#define CRYPTO3_R1CS_GG_PPZKSNARK_SMALL_SCALAR_MULTIEXP_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/iterator/indirect_iterator.hpp>
+
+#include <nil/crypto3/multiprecision/number.hpp>
+#include <nil/crypto3/multiprecision/cpp_int.hpp>
+
+#include <nil/crypto3/algebra/multiexp/multiexp.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace snark {
+                namespace detail {
+
+                    // Scalars of at most small_scalar_bits bits take the short-window path.
+                    constexpr static const std::size_t small_scalar_bits = 64;
+
+                    // Window for a bucket method over n scalars, about log2(n) - 2 bits.
+                    inline std::size_t small_scalar_window_bits(std::size_t n) {
+                        std::size_t log_n = 0;
+                        while ((std::size_t(1) << (log_n + 1)) <= n) {
+                            log_n++;
+                        }
+                        return std::min<std::size_t>(std::max<std::size_t>(log_n, 4) - 2, 16);
+                    }
+
+                    // sum_j scalars_j * bases_j by the bucket method, scalars have at most bits bits.
+                    template<typename GroupValueType>
+                    GroupValueType small_scalar_multiexp(const std::vector<const GroupValueType *> &bases,
+                                                         const std::vector<std::uint64_t> &scalars,
+                                                         std::size_t bits) {
+                        const std::size_t window_bits = small_scalar_window_bits(bases.size());
+                        const std::size_t windows = (bits + window_bits - 1) / window_bits;
+                        const std::uint64_t mask = (std::uint64_t(1) << window_bits) - 1;
+
+                        GroupValueType result = GroupValueType::zero();
+                        std::vector<GroupValueType> buckets(mask);
+                        for (std::size_t window = windows; window-- > 0;) {
+                            for (std::size_t t = 0; t < window_bits; t++) {
+                                result = result.doubled();
+                            }
+
+                            std::fill(buckets.begin(), buckets.end(), GroupValueType::zero());
+                            for (std::size_t j = 0; j < bases.size(); j++) {
+                                std::uint64_t digit = (scalars[j] >> (window * window_bits)) & mask;
+                                if (digit != 0) {
+                                    buckets[digit - 1] = buckets[digit - 1] + *bases[j];
+                                }
+                            }
+
+                            GroupValueType running = GroupValueType::zero();
+                            GroupValueType sum = GroupValueType::zero();
+                            for (std::size_t d = buckets.size(); d > 0; d--) {
+                                running = running + buckets[d - 1];
+                                sum = sum + running;
+                            }
+                            result = result + sum;
+                        }
+                        return result;
+                    }
+
+                    /**
+                     * Multiexp with the scalars sorted by size first: zeros are skipped, ones are added
+                     * to the result, scalars of up to small_scalar_bits bits go to a bucket method with windows
+                     * over their actual length, and only the others are left to MultiexpMethod.
+                     * Witnesses made of bits and small limbs rarely reach the full-width path.
+                     * Scalars that are almost all full width, such as the coefficients of H, should go to
+                     * MultiexpMethod directly, the sorting reads every scalar out of Montgomery form for nothing.
+                     */
+                    template<typename MultiexpMethod, typename BaseIterator, typename ScalarIterator>
+                    typename std::iterator_traits<BaseIterator>::value_type
+                        multiexp_by_scalar_size(BaseIterator bases_first, BaseIterator bases_last,
+                                                ScalarIterator scalars_first, ScalarIterator scalars_last,
+                                                std::size_t chunks) {
+                        typedef typename std::iterator_traits<BaseIterator>::value_type group_value_type;
+                        typedef typename std::iterator_traits<ScalarIterator>::value_type scalar_value_type;
+                        typedef typename scalar_value_type::field_type scalar_field_type;
+                        typedef typename scalar_field_type::integral_type integral_type;
+
+                        BOOST_ASSERT(std::distance(bases_first, bases_last) ==
+                                     std::distance(scalars_first, scalars_last));
+
+                        group_value_type ones_sum = group_value_type::zero();
+                        std::vector<const group_value_type *> small_bases;
+                        std::vector<std::uint64_t> small_scalars;
+                        std::size_t small_bits = 0;
+                        // The bases are not copied, the large ones are passed to MultiexpMethod by pointers.
+                        std::vector<const group_value_type *> large_bases;
+                        std::vector<scalar_value_type> large_scalars;
+
+                        const scalar_value_type zero = scalar_value_type::zero();
+                        const scalar_value_type one = scalar_value_type::one();
+
+                        BaseIterator base = bases_first;
+                        for (ScalarIterator scalar = scalars_first; scalar != scalars_last; ++scalar, ++base) {
+                            if (*scalar == zero) {
+                                continue;
+                            }
+                            if (*scalar == one) {
+#ifdef USE_MIXED_ADDITION
+                                ones_sum = ones_sum.mixed_add(*base);
+#else
+                                ones_sum = ones_sum + *base;
+#endif
+                                continue;
+                            }
+
+                            integral_type value = integral_type(scalar->data);
+                            bool large = false;
+                            for (std::size_t bit = small_scalar_bits; bit < scalar_field_type::modulus_bits; bit++) {
+                                if (multiprecision::bit_test(value, bit)) {
+                                    large = true;
+                                    break;
+                                }
+                            }
+                            if (large) {
+                                large_bases.push_back(&*base);
+                                large_scalars.push_back(*scalar);
+                                continue;
+                            }
+
+                            std::uint64_t small_value = 0;
+                            for (std::size_t bit = 0; bit < small_scalar_bits; bit++) {
+                                if (multiprecision::bit_test(value, bit)) {
+                                    small_value |= std::uint64_t(1) << bit;
+                                    small_bits = std::max(small_bits, bit + 1);
+                                }
+                            }
+                            small_bases.push_back(&*base);
+                            small_scalars.push_back(small_value);
+                        }
+
+                        group_value_type result = ones_sum;
+                        if (!small_bases.empty()) {
+                            result = result + small_scalar_multiexp(small_bases, small_scalars, small_bits);
+                        }
+                        if (!large_bases.empty()) {
+                            result = result + algebra::multiexp<MultiexpMethod>(
+                                                  boost::make_indirect_iterator(large_bases.begin()),
+                                                  boost::make_indirect_iterator(large_bases.end()),
+                                                  large_scalars.begin(), large_scalars.end(), chunks);
+                        }
+                        return result;
+                    }
+                }    // namespace detail
+            }        // namespace snark
+        }            // namespace zk
+    }                // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_R1CS_GG_PPZKSNARK_SMALL_SCALAR_MULTIEXP_HPP
@@ -67,6 +67,7 @@
 #include <nil/crypto3/multiprecision/modular/modular_adaptor.hpp>
 
 #include <nil/crypto3/zk/snark/systems/ppzksnark/r1cs_gg_ppzksnark.hpp>
+#include <nil/crypto3/zk/snark/systems/ppzksnark/r1cs_gg_ppzksnark/preprocessed_proving_key.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/constraint_satisfaction_problems/r1cs.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/variable.hpp>
 #include <nil/crypto3/zk/commitments/polynomial/knowledge_commitment.hpp>
@@ -737,6 +738,129 @@ namespace nil {
                         std::move(constraint_system)};
             }
 
+            template<typename TableType, typename GroupType, std::size_t PointByteblobSize, typename PointProcess>
+            static inline TableType
+            fixed_base_table_process(typename std::vector<chunk_type>::const_iterator &read_iter_current_begin,
+                                     typename std::vector<chunk_type>::const_iterator read_iter_end,
+                                     std::size_t expected_bases_num,
+                                     PointProcess point_process,
+                                     status_type &processingStatus) {
+
+                std::size_t parameters[3];
+                for (std::size_t &parameter : parameters) {
+                    parameter = std_size_t_process(read_iter_current_begin, read_iter_end, processingStatus);
+                    if (processingStatus != status_type::success) {
+                        return {};
+                    }
+                    read_iter_current_begin += std_size_t_byteblob_size;
+                }
+                std::size_t window_bits = parameters[0], stride = parameters[1], bases_num = parameters[2];
+                // The multiexps index the table by the positions of the proving key query it was built from.
+                if (window_bits == 0 || window_bits > TableType::max_window_bits || stride == 0 ||
+                    bases_num != expected_bases_num) {
+                    processingStatus = status_type::invalid_msg_data;
+                    return {};
+                }
+
+                std::size_t points_per_base =
+                    ((TableType::scalar_bits + window_bits - 1) / window_bits + stride - 1) / stride;
+                std::size_t available_points =
+                    std::size_t(std::distance(read_iter_current_begin, read_iter_end)) / PointByteblobSize;
+                // Compared by division, bases_num * points_per_base may overflow.
+                if (available_points / points_per_base < bases_num) {
+                    processingStatus = status_type::not_enough_data;
+                    return {};
+                }
+
+                std::vector<typename GroupType::value_type> points(bases_num * points_per_base);
+                for (auto &point : points) {
+                    point = point_process(read_iter_current_begin, read_iter_current_begin + PointByteblobSize,
+                                          processingStatus);
+                    if (processingStatus != status_type::success) {
+                        return {};
+                    }
+                    read_iter_current_begin += PointByteblobSize;
+                }
+
+                return TableType(window_bits, stride, bases_num, std::move(points));
+            }
+
+            // The proving key as written by proving key serialization with its byte size first,
+            // followed by the A, B.g, B.h, H and L fixed-base tables.
+            static inline r1cs_gg_ppzksnark_preprocessed_proving_key<typename scheme_type::proving_key_type>
+            preprocessed_proving_key_process(typename std::vector<chunk_type>::const_iterator read_iter_begin,
+                                             typename std::vector<chunk_type>::const_iterator read_iter_end,
+                                             status_type &processingStatus) {
+
+                using preprocessed_proving_key_type =
+                    r1cs_gg_ppzksnark_preprocessed_proving_key<typename scheme_type::proving_key_type>;
+                using g1_table_type = typename preprocessed_proving_key_type::g1_table_type;
+                using g2_table_type = typename preprocessed_proving_key_type::g2_table_type;
+                using g1_type = typename CurveType::template g1_type<>;
+                using g2_type = typename CurveType::template g2_type<>;
+
+                auto read_iter_current_begin = read_iter_begin;
+
+                std::size_t proving_key_size =
+                    std_size_t_process(read_iter_current_begin, read_iter_end, processingStatus);
+                if (processingStatus != status_type::success) {
+                    return {};
+                }
+                read_iter_current_begin += std_size_t_byteblob_size;
+                if (std::size_t(std::distance(read_iter_current_begin, read_iter_end)) < proving_key_size) {
+                    processingStatus = status_type::not_enough_data;
+                    return {};
+                }
+
+                typename scheme_type::proving_key_type proving_key = proving_key_process(
+                    read_iter_current_begin, read_iter_current_begin + proving_key_size, processingStatus);
+                if (processingStatus != status_type::success) {
+                    return {};
+                }
+                read_iter_current_begin += proving_key_size;
+
+                auto g1_process = [](typename std::vector<chunk_type>::const_iterator begin,
+                                     typename std::vector<chunk_type>::const_iterator end, status_type &status) {
+                    return g1_group_type_process<g1_type>(begin, end, status);
+                };
+                auto g2_process = [](typename std::vector<chunk_type>::const_iterator begin,
+                                     typename std::vector<chunk_type>::const_iterator end, status_type &status) {
+                    return g2_group_type_process<g2_type>(begin, end, status);
+                };
+
+                g1_table_type A_table = fixed_base_table_process<g1_table_type, g1_type, g1_byteblob_size>(
+                    read_iter_current_begin, read_iter_end, proving_key.A_query.size(), g1_process, processingStatus);
+                if (processingStatus != status_type::success) {
+                    return {};
+                }
+                g2_table_type B_g_table = fixed_base_table_process<g2_table_type, g2_type, g2_byteblob_size>(
+                    read_iter_current_begin, read_iter_end, proving_key.B_query.values.size(), g2_process,
+                    processingStatus);
+                if (processingStatus != status_type::success) {
+                    return {};
+                }
+                g1_table_type B_h_table = fixed_base_table_process<g1_table_type, g1_type, g1_byteblob_size>(
+                    read_iter_current_begin, read_iter_end, proving_key.B_query.values.size(), g1_process,
+                    processingStatus);
+                if (processingStatus != status_type::success) {
+                    return {};
+                }
+                g1_table_type H_table = fixed_base_table_process<g1_table_type, g1_type, g1_byteblob_size>(
+                    read_iter_current_begin, read_iter_end, proving_key.H_query.size(), g1_process, processingStatus);
+                if (processingStatus != status_type::success) {
+                    return {};
+                }
+                g1_table_type L_table = fixed_base_table_process<g1_table_type, g1_type, g1_byteblob_size>(
+                    read_iter_current_begin, read_iter_end, proving_key.L_query.size(), g1_process, processingStatus);
+                if (processingStatus != status_type::success) {
+                    return {};
+                }
+
+                return preprocessed_proving_key_type(std::move(proving_key), std::move(A_table),
+                                                     std::move(B_g_table), std::move(B_h_table), std::move(H_table),
+                                                     std::move(L_table));
+            }
+
             static inline typename scheme_type::primary_input_type
             primary_input_process(typename std::vector<chunk_type>::const_iterator read_iter_begin,
                                   typename std::vector<chunk_type>::const_iterator read_iter_end,
@@ -1162,6 +1286,58 @@ namespace nil {
                 return output;
             }
 
+            template<typename TableType, typename PointProcess>
+            static inline void fixed_base_table_process(const TableType &table, PointProcess point_process,
+                                                        std::vector<chunk_type>::iterator &write_iter) {
+
+                std_size_t_process(table.window_bits(), write_iter);
+                std_size_t_process(table.stride(), write_iter);
+                std_size_t_process(table.bases_num(), write_iter);
+
+                for (auto &point: table.points()) {
+                    point_process(point, write_iter);
+                }
+            }
+
+            static inline std::vector<chunk_type>
+            process(const r1cs_gg_ppzksnark_preprocessed_proving_key<typename scheme_type::proving_key_type> &ppk) {
+
+                using g1_type = typename CurveType::template g1_type<>;
+                using g2_type = typename CurveType::template g2_type<>;
+
+                std::vector<chunk_type> proving_key_output = process(ppk.proving_key);
+
+                std::size_t preprocessed_proving_key_size =
+                        std_size_t_byteblob_size + proving_key_output.size() + 5 * 3 * std_size_t_byteblob_size +
+                        (ppk.A_table.points().size() + ppk.B_h_table.points().size() +
+                         ppk.H_table.points().size() + ppk.L_table.points().size()) * g1_byteblob_size +
+                        ppk.B_g_table.points().size() * g2_byteblob_size;
+
+                std::vector<chunk_type> output(preprocessed_proving_key_size);
+
+                typename std::vector<chunk_type>::iterator write_iter = output.begin();
+
+                std_size_t_process(proving_key_output.size(), write_iter);
+                write_iter = std::copy(proving_key_output.begin(), proving_key_output.end(), write_iter);
+
+                auto g1_process = [](const typename g1_type::value_type &point,
+                                     std::vector<chunk_type>::iterator &iter) {
+                    g1_group_type_process<g1_type>(point, iter);
+                };
+                auto g2_process = [](const typename g2_type::value_type &point,
+                                     std::vector<chunk_type>::iterator &iter) {
+                    g2_group_type_process<g2_type>(point, iter);
+                };
+
+                fixed_base_table_process(ppk.A_table, g1_process, write_iter);
+                fixed_base_table_process(ppk.B_g_table, g2_process, write_iter);
+                fixed_base_table_process(ppk.B_h_table, g1_process, write_iter);
+                fixed_base_table_process(ppk.H_table, g1_process, write_iter);
+                fixed_base_table_process(ppk.L_table, g1_process, write_iter);
+
+                return output;
+            }
+
             static inline std::vector<chunk_type> process(typename scheme_type::verification_key_type vk) {
 
                 constexpr const std::size_t modulus_bits = CurveType::base_field_type::modulus_bits;
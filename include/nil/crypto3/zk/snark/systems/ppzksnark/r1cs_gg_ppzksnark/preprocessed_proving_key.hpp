@@ -0,0 +1,128 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_R1CS_GG_PPZKSNARK_PREPROCESSED_PROVING_KEY_HPP
+#define CRYPTO3_R1CS_GG_PPZKSNARK_PREPROCESSED_PROVING_KEY_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include <nil/crypto3/zk/snark/systems/ppzksnark/r1cs_gg_ppzksnark/proving_key.hpp>
+#include <nil/crypto3/zk/snark/systems/ppzksnark/r1cs_gg_ppzksnark/detail/fixed_base_multiexp.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace snark {
+                /**
+                 * A proving key with the fixed-base tables of its query vectors, built once and used by
+                 * the prover instead of the generic multiexp. See detail::fixed_base_table for window_bits
+                 * and stride: the tables keep ceil(ceil(b / window_bits) / stride) points per query point, b being
+                 * the number of bits of the scalar field modulus.
+                 * By default every table takes stride 1 and the window with the fewest additions for the prover
+                 * multiexp parts, e.g. 15 bits and 20 points per query point for b = 298 and 2^14 bases. A smaller
+                 * window or a larger stride keeps fewer points at the cost of speed.
+                 */
+                template<typename ProvingKeyType>
+                struct r1cs_gg_ppzksnark_preprocessed_proving_key {
+                    typedef ProvingKeyType proving_key_type;
+                    typedef typename proving_key_type::curve_type curve_type;
+                    typedef typename curve_type::scalar_field_type scalar_field_type;
+                    typedef detail::fixed_base_table<typename curve_type::template g1_type<>, scalar_field_type>
+                        g1_table_type;
+                    typedef detail::fixed_base_table<typename curve_type::template g2_type<>, scalar_field_type>
+                        g2_table_type;
+
+                    // Chooses the window of every table from its number of bases, see optimal_window_bits.
+                    constexpr static const std::size_t auto_window_bits = 0;
+                    constexpr static const std::size_t default_stride = 1;
+
+                    proving_key_type proving_key;
+
+                    g1_table_type A_table;
+                    // B_query.values[j].g and B_query.values[j].h
+                    g2_table_type B_g_table;
+                    g1_table_type B_h_table;
+                    g1_table_type H_table;
+                    g1_table_type L_table;
+
+                    r1cs_gg_ppzksnark_preprocessed_proving_key() = default;
+
+                    explicit r1cs_gg_ppzksnark_preprocessed_proving_key(const proving_key_type &proving_key,
+                                                                        std::size_t window_bits = auto_window_bits,
+                                                                        std::size_t stride = default_stride) :
+                        proving_key(proving_key) {
+                        std::vector<typename curve_type::template g2_type<>::value_type> B_g;
+                        std::vector<typename curve_type::template g1_type<>::value_type> B_h;
+                        for (const auto &value : proving_key.B_query.values) {
+                            B_g.push_back(value.g);
+                            B_h.push_back(value.h);
+                        }
+
+                        A_table = make_table<g1_table_type>(proving_key.A_query.begin(), proving_key.A_query.end(),
+                                                            window_bits, stride);
+                        B_g_table = make_table<g2_table_type>(B_g.begin(), B_g.end(), window_bits, stride);
+                        B_h_table = make_table<g1_table_type>(B_h.begin(), B_h.end(), window_bits, stride);
+                        H_table = make_table<g1_table_type>(proving_key.H_query.begin(), proving_key.H_query.end(),
+                                                            window_bits, stride);
+                        L_table = make_table<g1_table_type>(proving_key.L_query.begin(), proving_key.L_query.end(),
+                                                            window_bits, stride);
+                    }
+
+                    r1cs_gg_ppzksnark_preprocessed_proving_key(proving_key_type &&proving_key,
+                                                               g1_table_type &&A_table,
+                                                               g2_table_type &&B_g_table,
+                                                               g1_table_type &&B_h_table,
+                                                               g1_table_type &&H_table,
+                                                               g1_table_type &&L_table) :
+                        proving_key(std::move(proving_key)),
+                        A_table(std::move(A_table)), B_g_table(std::move(B_g_table)), B_h_table(std::move(B_h_table)),
+                        H_table(std::move(H_table)), L_table(std::move(L_table)) {
+                    }
+
+                    bool operator==(const r1cs_gg_ppzksnark_preprocessed_proving_key &other) const {
+                        return this->proving_key == other.proving_key && this->A_table == other.A_table &&
+                               this->B_g_table == other.B_g_table && this->B_h_table == other.B_h_table &&
+                               this->H_table == other.H_table && this->L_table == other.L_table;
+                    }
+
+                private:
+                    template<typename TableType, typename InputIterator>
+                    static TableType make_table(InputIterator first, InputIterator last, std::size_t window_bits,
+                                                std::size_t stride) {
+                        if (window_bits == auto_window_bits) {
+                            std::size_t part_size = std::min<std::size_t>(std::distance(first, last),
+                                                                          detail::multiexp_max_part_size);
+                            window_bits = TableType::optimal_window_bits(part_size);
+                        }
+                        return TableType(first, last, window_bits, stride);
+                    }
+                };
+            }    // namespace snark
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_R1CS_GG_PPZKSNARK_PREPROCESSED_PROVING_KEY_HPP
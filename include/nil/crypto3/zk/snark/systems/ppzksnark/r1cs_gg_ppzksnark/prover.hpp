@@ -30,15 +30,26 @@
 #include <omp.h>
 #endif
 
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include <nil/crypto3/algebra/multiexp/multiexp.hpp>
 #include <nil/crypto3/algebra/multiexp/policies.hpp>
 #include <nil/crypto3/algebra/random_element.hpp>
 
 #include <nil/crypto3/zk/commitments/polynomial/knowledge_commitment.hpp>
 #include <nil/crypto3/zk/commitments/polynomial/knowledge_commitment_multiexp.hpp>
+#include <nil/crypto3/zk/detail/task_graph.hpp>
+#include <nil/crypto3/zk/detail/thread_pool.hpp>
 
 #include <nil/crypto3/zk/snark/reductions/r1cs_to_qap.hpp>
+#include <nil/crypto3/zk/snark/systems/ppzksnark/r1cs_gg_ppzksnark/preprocessed_proving_key.hpp>
 #include <nil/crypto3/zk/snark/systems/ppzksnark/r1cs_gg_ppzksnark/detail/basic_policy.hpp>
+#include <nil/crypto3/zk/snark/systems/ppzksnark/r1cs_gg_ppzksnark/detail/small_scalar_multiexp.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -69,92 +80,415 @@ namespace nil {
                     typedef typename policy_type::auxiliary_input_type auxiliary_input_type;
                     typedef typename policy_type::proving_key_type proving_key_type;
                     typedef typename policy_type::proof_type proof_type;
+                    typedef r1cs_gg_ppzksnark_preprocessed_proving_key<proving_key_type> preprocessed_proving_key_type;
+
+                    // Duration of every stage of the last call, see zk::detail::task_graph::timings().
+                    typedef std::map<std::string, zk::detail::task_graph::task_timing> timings_type;
 
                     static inline proof_type process(const proving_key_type &proving_key,
                                                      const primary_input_type &primary_input,
                                                      const auxiliary_input_type &auxiliary_input) {
+                        timings_type timings;
+                        return process(proving_key, primary_input, auxiliary_input, timings);
+                    }
+
+                    static inline proof_type process(const proving_key_type &proving_key,
+                                                     const primary_input_type &primary_input,
+                                                     const auxiliary_input_type &auxiliary_input,
+                                                     timings_type &timings) {
+                        return process_inputs(proving_key, nullptr, {&primary_input}, {&auxiliary_input}, timings)
+                            .front();
+                    }
+
+                    // Same proof with the fixed-base tables of the key.
+                    static inline proof_type process(const preprocessed_proving_key_type &preprocessed_proving_key,
+                                                     const primary_input_type &primary_input,
+                                                     const auxiliary_input_type &auxiliary_input) {
+                        timings_type timings;
+                        return process(preprocessed_proving_key, primary_input, auxiliary_input, timings);
+                    }
+
+                    static inline proof_type process(const preprocessed_proving_key_type &preprocessed_proving_key,
+                                                     const primary_input_type &primary_input,
+                                                     const auxiliary_input_type &auxiliary_input,
+                                                     timings_type &timings) {
+                        return process_inputs(preprocessed_proving_key.proving_key, &preprocessed_proving_key,
+                                              {&primary_input}, {&auxiliary_input}, timings)
+                            .front();
+                    }
+
+                    /*
+                     * Proofs for several inputs with the same proving key. Every block of the query vectors is
+                     * traversed once for all the inputs while it is in cache, instead of once per proof.
+                     */
+                    static inline std::vector<proof_type>
+                        process_batch(const proving_key_type &proving_key,
+                                      const std::vector<primary_input_type> &primary_inputs,
+                                      const std::vector<auxiliary_input_type> &auxiliary_inputs) {
+                        timings_type timings;
+                        return process_batch(proving_key, primary_inputs, auxiliary_inputs, timings);
+                    }
+
+                    static inline std::vector<proof_type>
+                        process_batch(const proving_key_type &proving_key,
+                                      const std::vector<primary_input_type> &primary_inputs,
+                                      const std::vector<auxiliary_input_type> &auxiliary_inputs,
+                                      timings_type &timings) {
+                        return process_batch(proving_key, nullptr, primary_inputs, auxiliary_inputs, timings);
+                    }
+
+                    static inline std::vector<proof_type>
+                        process_batch(const preprocessed_proving_key_type &preprocessed_proving_key,
+                                      const std::vector<primary_input_type> &primary_inputs,
+                                      const std::vector<auxiliary_input_type> &auxiliary_inputs) {
+                        timings_type timings;
+                        return process_batch(preprocessed_proving_key, primary_inputs, auxiliary_inputs, timings);
+                    }
+
+                    static inline std::vector<proof_type>
+                        process_batch(const preprocessed_proving_key_type &preprocessed_proving_key,
+                                      const std::vector<primary_input_type> &primary_inputs,
+                                      const std::vector<auxiliary_input_type> &auxiliary_inputs,
+                                      timings_type &timings) {
+                        return process_batch(preprocessed_proving_key.proving_key, &preprocessed_proving_key,
+                                             primary_inputs, auxiliary_inputs, timings);
+                    }
+
+                private:
+                    static inline std::vector<proof_type>
+                        process_batch(const proving_key_type &proving_key,
+                                      const preprocessed_proving_key_type *preprocessed_proving_key,
+                                      const std::vector<primary_input_type> &primary_inputs,
+                                      const std::vector<auxiliary_input_type> &auxiliary_inputs,
+                                      timings_type &timings) {
+                        BOOST_ASSERT(primary_inputs.size() == auxiliary_inputs.size());
+
+                        std::vector<const primary_input_type *> primary_ptrs;
+                        std::vector<const auxiliary_input_type *> auxiliary_ptrs;
+                        for (std::size_t i = 0; i < primary_inputs.size(); i++) {
+                            primary_ptrs.push_back(&primary_inputs[i]);
+                            auxiliary_ptrs.push_back(&auxiliary_inputs[i]);
+                        }
+                        return process_inputs(proving_key, preprocessed_proving_key, primary_ptrs, auxiliary_ptrs,
+                                              timings);
+                    }
+
+                    constexpr static const std::size_t max_part_size = detail::multiexp_max_part_size;
 
-                        BOOST_ASSERT(proving_key.constraint_system.is_satisfied(primary_input, auxiliary_input));
+                    typedef reductions::r1cs_to_qap_workspace<scalar_field_type> qap_workspace_type;
 
-                        const qap_witness<scalar_field_type> qap_wit =
-                            reductions::r1cs_to_qap<scalar_field_type>::witness_map(
-                                proving_key.constraint_system, primary_input, auxiliary_input,
-                                scalar_field_type::value_type::zero(), scalar_field_type::value_type::zero(),
-                                scalar_field_type::value_type::zero());
+                    /*
+                     * witness_map workspaces of a call, so that the QAP domains and buffers are built once for a
+                     * circuit size. A witness_map task checks a workspace out and returns it when done, so a call
+                     * builds no more workspaces than witness_map tasks run at the same time, at most the pool
+                     * size. When the lease ends, the prover keeps up to the pool size of them for the next calls.
+                     */
+                    class qap_workspace_lease {
+                    public:
+                        explicit qap_workspace_lease(std::size_t size) {
+                            std::lock_guard<std::mutex> lock(mutex());
+                            std::vector<std::unique_ptr<qap_workspace_type>> &kept = kept_workspaces();
+                            while (_free.size() < size && !kept.empty()) {
+                                _free.push_back(std::move(kept.back()));
+                                kept.pop_back();
+                            }
+                        }
 
-                        /* We are dividing degree 2(d-1) polynomial by degree d polynomial
-                           and not adding a PGHR-style ZK-patch, so our H is degree d-2 */
-                        // BOOST_ASSERT(!qap_wit.coefficients_for_H[qap_wit.degree - 2].is_zero());
-                        BOOST_ASSERT(qap_wit.coefficients_for_H[qap_wit.degree - 1].is_zero());
-                        BOOST_ASSERT(qap_wit.coefficients_for_H[qap_wit.degree].is_zero());
+                        qap_workspace_lease(const qap_workspace_lease &) = delete;
+                        qap_workspace_lease &operator=(const qap_workspace_lease &) = delete;
+
+                        ~qap_workspace_lease() {
+                            std::lock_guard<std::mutex> lock(mutex());
+                            std::vector<std::unique_ptr<qap_workspace_type>> &kept = kept_workspaces();
+                            const std::size_t max_kept = zk::detail::thread_pool::instance().size();
+                            for (std::unique_ptr<qap_workspace_type> &workspace : _free) {
+                                if (kept.size() < max_kept) {
+                                    kept.push_back(std::move(workspace));
+                                }
+                            }
+                        }
+
+                        std::unique_ptr<qap_workspace_type> acquire() {
+                            std::lock_guard<std::mutex> lock(_free_mutex);
+                            if (_free.empty()) {
+                                return std::unique_ptr<qap_workspace_type>(new qap_workspace_type());
+                            }
+                            std::unique_ptr<qap_workspace_type> workspace = std::move(_free.back());
+                            _free.pop_back();
+                            return workspace;
+                        }
+
+                        void release(std::unique_ptr<qap_workspace_type> workspace) {
+                            std::lock_guard<std::mutex> lock(_free_mutex);
+                            _free.push_back(std::move(workspace));
+                        }
+
+                    private:
+                        static std::mutex &mutex() {
+                            static std::mutex instance;
+                            return instance;
+                        }
+
+                        static std::vector<std::unique_ptr<qap_workspace_type>> &kept_workspaces() {
+                            static std::vector<std::unique_ptr<qap_workspace_type>> instance;
+                            return instance;
+                        }
+
+                        std::mutex _free_mutex;
+                        std::vector<std::unique_ptr<qap_workspace_type>> _free;
+                    };
+
+                    /*
+                     * The stages run as a task graph on zk::detail::thread_pool::instance(). The A, B and L
+                     * multiexps depend on the assignment only and overlap with witness_map, whose FFTs are
+                     * needed by the H multiexp alone. Every multiexp is split into parts of its bases, at least
+                     * one per thread, and a part is computed for all the inputs one after another. With a pool
+                     * of one thread and a single input the stages run one after another as before.
+                     * The multiexps use the fixed-base tables of preprocessed_proving_key when it is given.
+                     * Otherwise the A and L scalars are sorted by size, see detail::multiexp_by_scalar_size.
+                     */
+                    static inline std::vector<proof_type>
+                        process_inputs(const proving_key_type &proving_key,
+                                       const preprocessed_proving_key_type *preprocessed_proving_key,
+                                       const std::vector<const primary_input_type *> &primary_inputs,
+                                       const std::vector<const auxiliary_input_type *> &auxiliary_inputs,
+                                       timings_type &timings) {
+                        typedef typename scalar_field_type::value_type scalar_value_type;
+                        typedef typename g1_type::value_type g1_value_type;
+                        typedef typename commitments::knowledge_commitment<g2_type, g1_type>::value_type kc_value_type;
+
+                        const std::size_t inputs_num = primary_inputs.size();
+                        for (std::size_t i = 0; i < inputs_num; i++) {
+                            BOOST_ASSERT(proving_key.constraint_system.is_satisfied(*primary_inputs[i],
+                                                                                     *auxiliary_inputs[i]));
+                        }
 
                         /* Choose two random field elements for prover zero-knowledge. */
-                        const typename scalar_field_type::value_type r = algebra::random_element<scalar_field_type>();
-                        const typename scalar_field_type::value_type s = algebra::random_element<scalar_field_type>();
+                        std::vector<scalar_value_type> r(inputs_num), s(inputs_num);
+                        for (std::size_t i = 0; i < inputs_num; i++) {
+                            r[i] = algebra::random_element<scalar_field_type>();
+                            s[i] = algebra::random_element<scalar_field_type>();
+                        }
+
+                        zk::detail::thread_pool &pool = zk::detail::thread_pool::instance();
 #ifdef MULTICORE
-                        const std::size_t chunks = omp_get_max_threads();    // to override, set OMP_NUM_THREADS env
-                                                                             // var or call omp_set_num_threads()
+                        // to override, set OMP_NUM_THREADS env var or call omp_set_num_threads()
+                        const std::size_t chunks = pool.size() == 1 ? omp_get_max_threads() : 1;
 #else
                         const std::size_t chunks = 1;
 #endif
 
+                        const std::size_t num_variables = proving_key.constraint_system.num_variables();
+                        const std::size_t num_inputs = proving_key.constraint_system.num_inputs();
+
                         // TODO: sort out indexing
-                        std::vector<typename scalar_field_type::value_type> const_padded_assignment(
-                            1, scalar_field_type::value_type::one());
-                        const_padded_assignment.insert(const_padded_assignment.end(),
-                                                       qap_wit.coefficients_for_ABCs.begin(),
-                                                       qap_wit.coefficients_for_ABCs.end());
-
-                        typename g1_type::value_type evaluation_At =
-                            algebra::multiexp_with_mixed_addition<algebra::policies::multiexp_method_BDLO12>(
-                                proving_key.A_query.begin(),
-                                proving_key.A_query.begin() + qap_wit.num_variables + 1,
-                                const_padded_assignment.begin(),
-                                const_padded_assignment.begin() + qap_wit.num_variables + 1,
-                                chunks);
-
-                        typename commitments::knowledge_commitment<g2_type, g1_type>::value_type evaluation_Bt =
-                            commitments::kc_multiexp_with_mixed_addition<algebra::policies::multiexp_method_BDLO12>(
-                                proving_key.B_query,
-                                0,
-                                qap_wit.num_variables + 1,
-                                const_padded_assignment.begin(),
-                                const_padded_assignment.begin() + qap_wit.num_variables + 1,
-                                chunks);
-
-                        typename g1_type::value_type evaluation_Ht =
-                            algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
-                                proving_key.H_query.begin(),
-                                proving_key.H_query.begin() + (qap_wit.degree - 1),
-                                qap_wit.coefficients_for_H.begin(),
-                                qap_wit.coefficients_for_H.begin() + (qap_wit.degree - 1),
-                                chunks);
-
-                        typename g1_type::value_type evaluation_Lt =
-                            algebra::multiexp_with_mixed_addition<algebra::policies::multiexp_method_BDLO12>(
-                                proving_key.L_query.begin(),
-                                proving_key.L_query.end(),
-                                const_padded_assignment.begin() + qap_wit.num_inputs + 1,
-                                const_padded_assignment.begin() + qap_wit.num_variables + 1,
-                                chunks);
-
-                        /* A = alpha + sum_i(a_i*A_i(t)) + r*delta */
-                        typename g1_type::value_type g1_A =
-                            proving_key.alpha_g1 + evaluation_At + r * proving_key.delta_g1;
-
-                        /* B = beta + sum_i(a_i*B_i(t)) + s*delta */
-                        typename g1_type::value_type g1_B =
-                            proving_key.beta_g1 + evaluation_Bt.h + s * proving_key.delta_g1;
-                        typename g2_type::value_type g2_B =
-                            proving_key.beta_g2 + evaluation_Bt.g + s * proving_key.delta_g2;
-
-                        /* C = sum_i(a_i*((beta*A_i(t) + alpha*B_i(t) + C_i(t)) + H(t)*Z(t))/delta) + A*s + r*b -
-                         * r*s*delta
-                         */
-                        typename g1_type::value_type g1_C =
-                            evaluation_Ht + evaluation_Lt + s * g1_A + r * g1_B - (r * s) * proving_key.delta_g1;
-
-                        return proof_type(std::move(g1_A), std::move(g2_B), std::move(g1_C));
+                        std::vector<std::vector<scalar_value_type>> const_padded_assignments(inputs_num);
+                        for (std::size_t i = 0; i < inputs_num; i++) {
+                            auto &assignment = const_padded_assignments[i];
+                            assignment.reserve(num_variables + 1);
+                            assignment.push_back(scalar_value_type::one());
+                            assignment.insert(assignment.end(), primary_inputs[i]->begin(), primary_inputs[i]->end());
+                            assignment.insert(assignment.end(), auxiliary_inputs[i]->begin(),
+                                              auxiliary_inputs[i]->end());
+                        }
+                        std::vector<std::unique_ptr<qap_witness<scalar_field_type>>> qap_wits(inputs_num);
+                        qap_workspace_lease qap_workspaces(std::min(inputs_num, pool.size()));
+
+                        zk::detail::task_graph graph;
+
+                        // [part][input] sums of the multiexps.
+                        auto parts_num = [&pool](std::size_t size) {
+                            return std::max<std::size_t>(
+                                std::min(size, std::max(pool.size(), (size + max_part_size - 1) / max_part_size)), 1);
+                        };
+                        std::vector<std::vector<g1_value_type>> evaluation_At_parts(
+                            parts_num(num_variables + 1), std::vector<g1_value_type>(inputs_num, g1_value_type::zero()));
+                        std::vector<std::vector<kc_value_type>> evaluation_Bt_parts(
+                            parts_num(num_variables + 1), std::vector<kc_value_type>(inputs_num, kc_value_type::zero()));
+                        std::vector<std::vector<g1_value_type>> evaluation_Ht_parts(
+                            parts_num(proving_key.H_query.size()),
+                            std::vector<g1_value_type>(inputs_num, g1_value_type::zero()));
+                        std::vector<std::vector<g1_value_type>> evaluation_Lt_parts(
+                            parts_num(proving_key.L_query.size()),
+                            std::vector<g1_value_type>(inputs_num, g1_value_type::zero()));
+
+                        // Adds func(part_begin, part_end, part) for the parts of [0, size) depending on dependencies.
+                        auto add_parts = [&graph, &parts_num](const std::string &name, std::size_t size, auto func,
+                                                              const std::vector<zk::detail::task_graph::task_id>
+                                                                  &dependencies) {
+                            std::size_t parts = parts_num(size);
+                            std::size_t part_size = std::max<std::size_t>((size + parts - 1) / parts, 1);
+                            for (std::size_t part = 0; part * part_size < size; part++) {
+                                std::size_t part_begin = part * part_size;
+                                std::size_t part_end = std::min(size, part_begin + part_size);
+                                graph.add(name, [func, part_begin, part_end, part]() {
+                                    func(part_begin, part_end, part);
+                                }, dependencies);
+                            }
+                        };
+
+                        // Added first, they are the longest chain.
+                        std::vector<zk::detail::task_graph::task_id> witness_map_tasks;
+                        for (std::size_t i = 0; i < inputs_num; i++) {
+                            witness_map_tasks.push_back(graph.add("witness_map", [&, i]() {
+                                std::unique_ptr<qap_workspace_type> workspace = qap_workspaces.acquire();
+                                qap_wits[i].reset(new qap_witness<scalar_field_type>(
+                                    reductions::r1cs_to_qap<scalar_field_type>::witness_map(
+                                        proving_key.constraint_system, *primary_inputs[i], *auxiliary_inputs[i],
+                                        scalar_value_type::zero(), scalar_value_type::zero(),
+                                        scalar_value_type::zero(), *workspace)));
+                                qap_workspaces.release(std::move(workspace));
+
+                                /* We are dividing degree 2(d-1) polynomial by degree d polynomial
+                                   and not adding a PGHR-style ZK-patch, so our H is degree d-2 */
+                                // BOOST_ASSERT(!qap_wits[i]->coefficients_for_H[qap_wits[i]->degree - 2].is_zero());
+                                BOOST_ASSERT(qap_wits[i]->coefficients_for_H[qap_wits[i]->degree - 1].is_zero());
+                                BOOST_ASSERT(qap_wits[i]->coefficients_for_H[qap_wits[i]->degree].is_zero());
+                            }));
+                        }
+
+                        // The degree of the QAP is known after witness_map only, H is split into parts of H_query.
+                        add_parts("H", proving_key.H_query.size(),
+                                  [&](std::size_t part_begin, std::size_t part_end, std::size_t part) {
+                                      for (std::size_t i = 0; i < inputs_num; i++) {
+                                          std::size_t end = std::min(part_end, qap_wits[i]->degree - 1);
+                                          if (part_begin >= end) {
+                                              continue;
+                                          }
+                                          if (preprocessed_proving_key) {
+                                              evaluation_Ht_parts[part][i] = preprocessed_proving_key->H_table.multiexp(
+                                                  part_begin,
+                                                  qap_wits[i]->coefficients_for_H.begin() + part_begin,
+                                                  qap_wits[i]->coefficients_for_H.begin() + end);
+                                              continue;
+                                          }
+                                          evaluation_Ht_parts[part][i] =
+                                              algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
+                                                  proving_key.H_query.begin() + part_begin,
+                                                  proving_key.H_query.begin() + end,
+                                                  qap_wits[i]->coefficients_for_H.begin() + part_begin,
+                                                  qap_wits[i]->coefficients_for_H.begin() + end,
+                                                  chunks);
+                                      }
+                                  },
+                                  witness_map_tasks);
+
+                        add_parts("A", num_variables + 1,
+                                  [&](std::size_t part_begin, std::size_t part_end, std::size_t part) {
+                                      for (std::size_t i = 0; i < inputs_num; i++) {
+                                          if (preprocessed_proving_key) {
+                                              evaluation_At_parts[part][i] = preprocessed_proving_key->A_table.multiexp(
+                                                  part_begin,
+                                                  const_padded_assignments[i].begin() + part_begin,
+                                                  const_padded_assignments[i].begin() + part_end);
+                                              continue;
+                                          }
+                                          evaluation_At_parts[part][i] = detail::multiexp_by_scalar_size<
+                                              algebra::policies::multiexp_method_BDLO12>(
+                                              proving_key.A_query.begin() + part_begin,
+                                              proving_key.A_query.begin() + part_end,
+                                              const_padded_assignments[i].begin() + part_begin,
+                                              const_padded_assignments[i].begin() + part_end,
+                                              chunks);
+                                      }
+                                  },
+                                  {});
+
+                        add_parts("B", num_variables + 1,
+                                  [&](std::size_t part_begin, std::size_t part_end, std::size_t part) {
+                                      // Positions of the nonzero entries of B_query in the part.
+                                      const auto &indices = proving_key.B_query.indices;
+                                      std::size_t values_begin =
+                                          std::lower_bound(indices.begin(), indices.end(), part_begin) - indices.begin();
+                                      std::size_t values_end =
+                                          std::lower_bound(indices.begin(), indices.end(), part_end) - indices.begin();
+                                      for (std::size_t i = 0; i < inputs_num; i++) {
+                                          if (preprocessed_proving_key) {
+                                              std::vector<scalar_value_type> scalars;
+                                              scalars.reserve(values_end - values_begin);
+                                              for (std::size_t j = values_begin; j < values_end; j++) {
+                                                  scalars.push_back(const_padded_assignments[i][indices[j]]);
+                                              }
+                                              evaluation_Bt_parts[part][i] = kc_value_type(
+                                                  preprocessed_proving_key->B_g_table.multiexp(
+                                                      values_begin, scalars.begin(), scalars.end()),
+                                                  preprocessed_proving_key->B_h_table.multiexp(
+                                                      values_begin, scalars.begin(), scalars.end()));
+                                              continue;
+                                          }
+                                          evaluation_Bt_parts[part][i] = commitments::kc_multiexp_with_mixed_addition<
+                                              algebra::policies::multiexp_method_BDLO12>(
+                                              proving_key.B_query,
+                                              part_begin,
+                                              part_end,
+                                              const_padded_assignments[i].begin() + part_begin,
+                                              const_padded_assignments[i].begin() + part_end,
+                                              chunks);
+                                      }
+                                  },
+                                  {});
+
+                        add_parts("L", proving_key.L_query.size(),
+                                  [&](std::size_t part_begin, std::size_t part_end, std::size_t part) {
+                                      for (std::size_t i = 0; i < inputs_num; i++) {
+                                          if (preprocessed_proving_key) {
+                                              evaluation_Lt_parts[part][i] = preprocessed_proving_key->L_table.multiexp(
+                                                  part_begin,
+                                                  const_padded_assignments[i].begin() + num_inputs + 1 + part_begin,
+                                                  const_padded_assignments[i].begin() + num_inputs + 1 + part_end);
+                                              continue;
+                                          }
+                                          evaluation_Lt_parts[part][i] = detail::multiexp_by_scalar_size<
+                                              algebra::policies::multiexp_method_BDLO12>(
+                                              proving_key.L_query.begin() + part_begin,
+                                              proving_key.L_query.begin() + part_end,
+                                              const_padded_assignments[i].begin() + num_inputs + 1 + part_begin,
+                                              const_padded_assignments[i].begin() + num_inputs + 1 + part_end,
+                                              chunks);
+                                      }
+                                  },
+                                  {});
+
+                        graph.run(pool);
+                        timings = graph.timings();
+
+                        std::vector<proof_type> proofs;
+                        proofs.reserve(inputs_num);
+                        for (std::size_t i = 0; i < inputs_num; i++) {
+                            g1_value_type evaluation_At = g1_value_type::zero();
+                            for (const auto &part : evaluation_At_parts) {
+                                evaluation_At = evaluation_At + part[i];
+                            }
+                            kc_value_type evaluation_Bt = kc_value_type::zero();
+                            for (const auto &part : evaluation_Bt_parts) {
+                                evaluation_Bt = evaluation_Bt + part[i];
+                            }
+                            g1_value_type evaluation_Ht = g1_value_type::zero();
+                            for (const auto &part : evaluation_Ht_parts) {
+                                evaluation_Ht = evaluation_Ht + part[i];
+                            }
+                            g1_value_type evaluation_Lt = g1_value_type::zero();
+                            for (const auto &part : evaluation_Lt_parts) {
+                                evaluation_Lt = evaluation_Lt + part[i];
+                            }
+
+                            /* A = alpha + sum_i(a_i*A_i(t)) + r*delta */
+                            g1_value_type g1_A = proving_key.alpha_g1 + evaluation_At + r[i] * proving_key.delta_g1;
+
+                            /* B = beta + sum_i(a_i*B_i(t)) + s*delta */
+                            g1_value_type g1_B = proving_key.beta_g1 + evaluation_Bt.h + s[i] * proving_key.delta_g1;
+                            typename g2_type::value_type g2_B =
+                                proving_key.beta_g2 + evaluation_Bt.g + s[i] * proving_key.delta_g2;
+
+                            /* C = sum_i(a_i*((beta*A_i(t) + alpha*B_i(t) + C_i(t)) + H(t)*Z(t))/delta) + A*s + r*b -
+                             * r*s*delta
+                             */
+                            g1_value_type g1_C = evaluation_Ht + evaluation_Lt + s[i] * g1_A + r[i] * g1_B -
+                                                 (r[i] * s[i]) * proving_key.delta_g1;
+
+                            proofs.emplace_back(std::move(g1_A), std::move(g2_B), std::move(g1_C));
+                        }
+                        return proofs;
                     }
                 };
             }    // namespace snark
@@ -181,6 +181,11 @@ namespace nil {
                         return result;
                     }
 
+                    // Digest the next data is absorbed into.
+                    const typename hash_type::digest_type &get_state() const {
+                        return state;
+                    }
+
                 private:
                     typename hash_type::digest_type state;
                 };
@@ -0,0 +1,87 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE barycentric_evaluation_test
+
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/algebra/curves/pallas.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/pallas.hpp>
+#include <nil/crypto3/algebra/random_element.hpp>
+
+#include <nil/crypto3/math/algorithms/unity_root.hpp>
+#include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
+
+#include <nil/crypto3/zk/commitments/detail/polynomial/barycentric_evaluation.hpp>
+#include <nil/crypto3/zk/detail/thread_pool.hpp>
+
+using namespace nil::crypto3;
+
+template<typename FieldType>
+void test_barycentric_evaluate(std::size_t size, std::size_t polys_num) {
+    using value_type = typename FieldType::value_type;
+    using polynomial_dfs_type = math::polynomial_dfs<value_type>;
+
+    std::vector<polynomial_dfs_type> polys;
+    for (std::size_t k = 0; k < polys_num; k++) {
+        std::vector<value_type> values(size);
+        for (value_type &value : values) {
+            value = algebra::random_element<FieldType>();
+        }
+        polys.emplace_back(size - 1, values);
+    }
+    std::vector<const polynomial_dfs_type *> poly_ptrs;
+    for (const polynomial_dfs_type &poly : polys) {
+        poly_ptrs.push_back(&poly);
+    }
+
+    // A point off the domain and a point of the domain, whose values are read from the polynomials.
+    for (const value_type &x : {algebra::random_element<FieldType>(), math::unity_root<FieldType>(size).pow(3)}) {
+        std::vector<value_type> result = zk::commitments::detail::barycentric_evaluate<FieldType>(poly_ptrs, x);
+        BOOST_CHECK_EQUAL(result.size(), polys_num);
+        for (std::size_t k = 0; k < polys_num; k++) {
+            BOOST_CHECK(result[k] == polys[k].evaluate(x));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(barycentric_evaluation_test_suite)
+
+BOOST_AUTO_TEST_CASE(barycentric_evaluation_test) {
+    using field_type = typename algebra::curves::pallas::base_field_type;
+
+    // With 4 threads, 2 polynomials are split by chunks of the domain and 6 are evaluated one per task.
+    for (std::size_t threads : {1, 4}) {
+        zk::detail::thread_pool::instance().resize(threads);
+        test_barycentric_evaluate<field_type>(8, 2);
+        test_barycentric_evaluate<field_type>(8, 6);
+        test_barycentric_evaluate<field_type>(1 << 13, 2);
+        test_barycentric_evaluate<field_type>(1 << 13, 6);
+    }
+    zk::detail::thread_pool::instance().resize(1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
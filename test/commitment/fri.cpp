@@ -50,7 +50,9 @@
 
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 #include <nil/crypto3/zk/commitments/polynomial/fri.hpp>
+#include <nil/crypto3/zk/commitments/detail/polynomial/fri_params_tuner.hpp>
 #include <nil/crypto3/zk/commitments/type_traits.hpp>
+#include <nil/crypto3/zk/detail/thread_pool.hpp>
 
 #include <nil/crypto3/random/algebraic_random_device.hpp>
 
@@ -142,4 +144,150 @@ BOOST_AUTO_TEST_CASE(fri_basic_test) {
     typename FieldType::value_type prover_next_challenge = transcript.template challenge<FieldType>();
     BOOST_CHECK(verifier_next_challenge == prover_next_challenge);
 }
+BOOST_AUTO_TEST_CASE(fri_leaf_bytes_test) {
+    using curve_type = algebra::curves::pallas;
+    using FieldType = typename curve_type::base_field_type;
+    using value_type = typename FieldType::value_type;
+
+    typedef hashes::sha2<256> merkle_hash_type;
+    typedef hashes::sha2<256> transcript_hash_type;
+
+    typedef zk::commitments::fri<FieldType, merkle_hash_type, transcript_hash_type, 2, 2> fri_type;
+
+    // The leaf writer gives the bytes of field_element_type::write.
+    std::vector<value_type> values = {value_type::zero(), value_type::one(), -value_type::one(), value_type(0x1234)};
+    for (std::size_t i = 0; i < 16; i++) {
+        values.push_back(algebra::random_element<FieldType>());
+    }
+    const std::size_t length = fri_type::field_element_type::length();
+
+    std::vector<std::uint8_t> expected(values.size() * length);
+    auto expected_iter = expected.begin();
+    for (const auto &value : values) {
+        typename fri_type::field_element_type marshalled(value);
+        marshalled.write(expected_iter, length);
+    }
+
+    std::vector<std::uint8_t> written(values.size() * length);
+    auto written_iter = written.begin();
+    zk::algorithms::write_field_elements<fri_type>(values.cbegin(), values.cend(), written_iter);
+    BOOST_CHECK(written_iter == written.end());
+    BOOST_CHECK(written == expected);
+
+    std::vector<std::size_t> indices = {3, 0, 2};
+    std::vector<std::uint8_t> coset(indices.size() * length);
+    auto coset_iter = coset.begin();
+    zk::algorithms::write_field_elements<fri_type>(values, indices, coset_iter);
+    for (std::size_t i = 0; i < indices.size(); i++) {
+        BOOST_CHECK(std::equal(coset.begin() + i * length, coset.begin() + (i + 1) * length,
+                               expected.begin() + indices[i] * length));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(proof_of_work_test) {
+    typedef hashes::sha2<256> transcript_hash_type;
+    using transcript_type = zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type>;
+
+    std::vector<std::uint8_t> init_blob {0u, 0xaa, 0xbb};
+
+    // The nonce depends on the transcript and the seed only.
+    using grinding_type = zk::commitments::proof_of_work<transcript_hash_type>;
+    transcript_type transcript(init_blob);
+    transcript_type transcript_repeated(init_blob);
+    auto nonce = grinding_type::generate(transcript);
+    BOOST_CHECK(nonce == grinding_type::generate(transcript_repeated));
+    BOOST_CHECK(transcript.template int_challenge<std::uint64_t>() ==
+                transcript_repeated.template int_challenge<std::uint64_t>());
+
+    transcript_type transcript_verifier(init_blob);
+    BOOST_CHECK(grinding_type::verify(transcript_verifier, nonce));
+
+    transcript_type transcript_seeded(init_blob);
+    auto seeded_nonce = grinding_type::generate(transcript_seeded, nonce);
+    BOOST_CHECK(seeded_nonce == nonce);
+
+    // The same nonce for any number of threads, found after several batches of the search.
+    using engine_type = zk::commitments::detail::grinding_engine<transcript_hash_type, std::uint64_t>;
+    const std::uint64_t mask = zk::commitments::detail::grinding_mask<std::uint64_t>(16);
+    const std::size_t batch_size = 4096;
+    auto generate = [&](std::uint64_t seed, std::size_t threads) {
+        zk::detail::thread_pool::instance().resize(threads);
+        transcript_type transcript_engine(init_blob);
+        return engine_type::generate(transcript_engine, mask, seed, batch_size);
+    };
+    // A seed whose first batch holds no valid nonce.
+    std::uint64_t seed = 0;
+    std::uint64_t engine_nonce = generate(seed, 1);
+    while (engine_nonce - seed < batch_size) {
+        seed = engine_nonce + 1;
+        engine_nonce = generate(seed, 1);
+    }
+    BOOST_CHECK(engine_nonce == generate(seed, 4));
+    transcript_type transcript_engine_verifier(init_blob);
+    BOOST_CHECK(engine_type::verify(transcript_engine_verifier, engine_nonce, mask));
+    zk::detail::thread_pool::instance().resize(1);
+
+    // Difficulty given in bits, beyond the 32-bit challenge of the default mask.
+    using grinding_bits_type = zk::commitments::proof_of_work_bits<transcript_hash_type, 12>;
+    BOOST_CHECK(zk::commitments::detail::grinding_mask<std::uint64_t>(12) == 0xFFF0000000000000ull);
+    BOOST_CHECK(grinding_bits_type::grinding_bits == 12);
+    BOOST_CHECK(zk::commitments::proof_of_work<transcript_hash_type>::grinding_bits == 16);
+    transcript_type transcript_bits(init_blob);
+    auto nonce_bits = grinding_bits_type::generate(transcript_bits, 1000);
+    BOOST_CHECK(nonce_bits >= 1000);
+    transcript_type transcript_bits_verifier(init_blob);
+    BOOST_CHECK(grinding_bits_type::verify(transcript_bits_verifier, nonce_bits));
+}
+
+BOOST_AUTO_TEST_CASE(fri_params_tuner_test) {
+    using curve_type = algebra::curves::pallas;
+    using FieldType = typename curve_type::base_field_type;
+
+    typedef hashes::sha2<256> merkle_hash_type;
+    typedef hashes::sha2<256> transcript_hash_type;
+
+    typedef zk::commitments::fri<FieldType, merkle_hash_type, transcript_hash_type, 40, 2, true> fri_type;
+
+    auto measured = zk::commitments::fri_cost_model::measure<FieldType, merkle_hash_type>(1 << 12);
+    BOOST_CHECK(measured.field_mul > 0);
+    BOOST_CHECK(measured.hash_block > 0);
+
+    // A fixed model keeps the choices reproducible.
+    zk::commitments::fri_cost_model model;
+    model.field_mul = 1e-7;
+    model.hash_block = 5e-7;
+    model.threads = 8;
+
+    zk::commitments::fri_tuning_request request;
+    request.security_bits = 100;
+    request.rows = 1 << 10;
+    request.batches_num = 4;
+    request.polys_num = 60;
+
+    auto choices = zk::algorithms::tune_fri_params<fri_type>(request, model);
+    BOOST_CHECK(!choices.empty());
+    for (std::size_t i = 0; i < choices.size(); i++) {
+        const auto &choice = choices[i];
+        BOOST_CHECK(choice.security_bits >= request.security_bits);
+        BOOST_CHECK(choice.lambda * choice.expand_factor + choice.grinding_bits >= request.security_bits);
+        if (i > 0) {
+            BOOST_CHECK(choices[i - 1].prover_seconds <= choice.prover_seconds);
+        }
+        for (const auto &other : choices) {
+            BOOST_CHECK(!other.dominates(choice));
+        }
+
+        auto params = zk::algorithms::make_fri_params<fri_type>(choice, request.rows);
+        BOOST_CHECK(zk::algorithms::check_step_list<fri_type>(params));
+        BOOST_CHECK(params.D[0]->size() == request.rows << choice.expand_factor);
+    }
+
+    // The grinding of a choice is applied through the FRI type.
+    using chosen_grinding_type = zk::commitments::fri_grinding_type<transcript_hash_type, 16>;
+    typedef zk::commitments::fri<FieldType, merkle_hash_type, transcript_hash_type, 40, 2, true, chosen_grinding_type>
+        chosen_fri_type;
+    BOOST_CHECK(chosen_fri_type::use_grinding);
+    BOOST_CHECK(chosen_fri_type::grinding_type::grinding_bits == 16);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -258,6 +258,158 @@ BOOST_FIXTURE_TEST_CASE(lpc_basic_test, test_fixture) {
     typename FieldType::value_type verifier_next_challenge = transcript_verifier.template challenge<FieldType>();
     typename FieldType::value_type prover_next_challenge = transcript.template challenge<FieldType>();
     BOOST_CHECK(verifier_next_challenge == prover_next_challenge);
+
+    // Verify the same proof with compressed Merkle multi-proofs
+    auto compressed_proof = lpc_type::compress_proof(proof);
+    lpc_scheme_type lpc_scheme_compressed_verifier(fri_params);
+    zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript_compressed_verifier(x_data);
+    for (std::size_t batch = 0; batch < 4; batch++) {
+        lpc_scheme_compressed_verifier.set_batch_size(batch, proof.z.get_batch_size(batch));
+        lpc_scheme_compressed_verifier.append_eval_point(batch, point);
+    }
+    BOOST_CHECK(lpc_scheme_compressed_verifier.verify_eval(compressed_proof, commitments, transcript_compressed_verifier));
+
+    // Shared sibling nodes are stored once
+    std::size_t full_proof_digests = 0;
+    for (const auto &query_proof : proof.fri_proof.query_proofs) {
+        for (const auto &[k, initial_proof] : query_proof.initial_proof) {
+            full_proof_digests += initial_proof.p.path().size();
+        }
+        for (const auto &round_proof : query_proof.round_proofs) {
+            full_proof_digests += round_proof.p.path().size();
+        }
+    }
+    std::size_t compressed_proof_digests = 0;
+    for (const auto &[k, multiproof] : compressed_proof.fri_proof.initial_multiproofs) {
+        compressed_proof_digests += multiproof.siblings.size();
+    }
+    for (const auto &multiproof : compressed_proof.fri_proof.round_multiproofs) {
+        compressed_proof_digests += multiproof.siblings.size();
+    }
+    BOOST_CHECK(compressed_proof_digests < full_proof_digests);
+
+    // Modified multi-proofs are rejected
+    auto verify_compressed = [&](const typename lpc_type::compressed_proof_type &modified_proof) {
+        lpc_scheme_type verifier(fri_params);
+        zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> verifier_transcript(x_data);
+        for (std::size_t batch = 0; batch < 4; batch++) {
+            verifier.set_batch_size(batch, proof.z.get_batch_size(batch));
+            verifier.append_eval_point(batch, point);
+        }
+        return verifier.verify_eval(modified_proof, commitments, verifier_transcript);
+    };
+    auto &initial_siblings = compressed_proof.fri_proof.initial_multiproofs.begin()->second.siblings;
+    BOOST_CHECK(!initial_siblings.empty());
+
+    auto flipped_proof = compressed_proof;
+    auto &flipped_siblings = flipped_proof.fri_proof.initial_multiproofs.begin()->second.siblings;
+    flipped_siblings[0][0] ^= 1;
+    BOOST_CHECK(!verify_compressed(flipped_proof));
+
+    auto dropped_proof = compressed_proof;
+    dropped_proof.fri_proof.initial_multiproofs.begin()->second.siblings.pop_back();
+    BOOST_CHECK(!verify_compressed(dropped_proof));
+
+    auto extra_proof = compressed_proof;
+    extra_proof.fri_proof.round_multiproofs.back().siblings.push_back(initial_siblings.front());
+    BOOST_CHECK(!verify_compressed(extra_proof));
+}
+
+BOOST_AUTO_TEST_CASE(lpc_eval_storage_test) {
+    typedef algebra::curves::bls12<381>::scalar_field_type FieldType;
+    typedef typename FieldType::value_type value_type;
+    typedef zk::commitments::eval_storage<FieldType> eval_storage_type;
+
+    // Batch 2 first, then batch 0 is inserted before it.
+    eval_storage_type z;
+    z.set_batch_size(2, 2);
+    z.set_poly_points_number(2, 0, 1);
+    z.set_poly_points_number(2, 1, 3);
+    for (std::size_t j = 0; j < 3; j++) {
+        z.set(2, 1, j, value_type(20 + j));
+    }
+    z.set(2, 0, 0, value_type(10));
+
+    z.set_batch_size(0, 1);
+    z.set_poly_points_number(0, 0, 2);
+    z.set(0, 0, 0, value_type(1));
+    z.set(0, 0, 1, value_type(2));
+
+    BOOST_CHECK(z.get_batches() == std::vector<std::size_t>({0, 2}));
+    BOOST_CHECK_EQUAL(z.get_batches_num(), 2);
+    BOOST_CHECK(z.get(0, 0, 1) == value_type(2));
+    BOOST_CHECK(z.get(2, 0, 0) == value_type(10));
+    BOOST_CHECK(z.get(2, 1, 2) == value_type(22));
+    BOOST_CHECK(z.values() == std::vector<value_type>({1, 2, 10, 20, 21, 22}));
+    BOOST_CHECK_THROW(z.get(1), std::out_of_range);
+
+    // Re-sizing a batch drops its values and keeps the others in place.
+    z.set_batch_size(0, 2);
+    BOOST_CHECK_EQUAL(z.get_batch_size(0), 2);
+    BOOST_CHECK_EQUAL(z.get_poly_points_number(0, 1), 0);
+    BOOST_CHECK(z.get(2, 1, 0) == value_type(20));
+    z.set_poly_points_number(0, 1, 1);
+    z.set(0, 1, 0, value_type(5));
+    BOOST_CHECK(z.values() == std::vector<value_type>({5, 10, 20, 21, 22}));
+
+    // The storage order with the points numbers gives the same storage.
+    eval_storage_type decoded({{0, {0, 1}}, {2, {1, 3}}}, std::vector<value_type>(z.values()));
+    BOOST_CHECK(decoded == z);
+    BOOST_CHECK_THROW(eval_storage_type({{0, {0, 1}}, {2, {1, 3}}}, std::vector<value_type>(4)),
+                      std::invalid_argument);
+
+    // Batch ids of a decoded proof are bounded before anything is allocated for them.
+    BOOST_CHECK_THROW(eval_storage_type({{std::size_t(1) << 40, {1}}}, std::vector<value_type>(1)),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(z.set_batch_size(eval_storage_type::max_batch_id + 1, 1), std::invalid_argument);
+    BOOST_CHECK(z.values() == std::vector<value_type>({5, 10, 20, 21, 22}));
+}
+
+BOOST_AUTO_TEST_CASE(lpc_merkle_multiproof_test) {
+    typedef hashes::sha2<256> merkle_hash_type;
+    typedef zk::commitments::detail::merkle_multiproof<merkle_hash_type> multiproof_type;
+    typedef typename multiproof_type::node_type node_type;
+
+    constexpr static const std::size_t depth = 5;
+    constexpr static const std::size_t leaf_bytes = 8;
+
+    zk::commitments::detail::flat_leaves_buffer leaves(1 << depth, leaf_bytes);
+    for (std::size_t i = 0; i < leaves.size(); i++) {
+        std::fill(leaves.leaf_begin(i), leaves.leaf_begin(i) + leaf_bytes, std::uint8_t(i));
+    }
+    auto tree = zk::commitments::detail::make_merkle_tree_parallel<merkle_hash_type, 2>(leaves);
+    const zk::commitments::detail::flat_leaves_buffer &written_leaves = leaves;
+
+    std::vector<typename multiproof_type::merkle_proof_type> proofs;
+    std::vector<node_type> nodes;
+    for (std::size_t leaf_index : {3, 4, 5, 17, 4, 30}) {
+        proofs.emplace_back(tree, leaf_index);
+        nodes.emplace_back(leaf_index, crypto3::hash<merkle_hash_type>(written_leaves.leaf_begin(leaf_index),
+                                                                       written_leaves.leaf_end(leaf_index)));
+    }
+    multiproof_type multiproof = multiproof_type::from_proofs(proofs);
+    BOOST_CHECK(multiproof.validate(tree.root(), depth, nodes));
+    BOOST_CHECK(multiproof.siblings.size() < proofs.size() * depth);
+
+    multiproof_type flipped = multiproof;
+    flipped.siblings[1][0] ^= 1;
+    BOOST_CHECK(!flipped.validate(tree.root(), depth, nodes));
+
+    multiproof_type dropped = multiproof;
+    dropped.siblings.pop_back();
+    BOOST_CHECK(!dropped.validate(tree.root(), depth, nodes));
+
+    multiproof_type extra = multiproof;
+    extra.siblings.push_back(multiproof.siblings.front());
+    BOOST_CHECK(!extra.validate(tree.root(), depth, nodes));
+
+    std::vector<node_type> out_of_range_nodes = nodes;
+    out_of_range_nodes.back().first += 1 << depth;
+    BOOST_CHECK(!multiproof.validate(tree.root(), depth, out_of_range_nodes));
+
+    std::vector<node_type> moved_nodes = nodes;
+    moved_nodes.back().first = 31;
+    BOOST_CHECK(!multiproof.validate(tree.root(), depth, moved_nodes));
 }
 
 BOOST_FIXTURE_TEST_CASE(lpc_basic_skipping_layers_test, test_fixture) {
@@ -451,6 +603,84 @@ BOOST_FIXTURE_TEST_CASE(lpc_dfs_basic_test, test_fixture) {
 }
 BOOST_AUTO_TEST_SUITE_END()
 
+// Two random batches over bls12-381 committed with caller-chosen FRI step lists.
+struct lpc_step_list_fixture : public test_fixture {
+    typedef algebra::curves::bls12<381> curve_type;
+    typedef typename curve_type::scalar_field_type FieldType;
+
+    typedef hashes::sha2<256> merkle_hash_type;
+    typedef hashes::sha2<256> transcript_hash_type;
+
+    constexpr static const std::size_t lambda = 10;
+    constexpr static const std::size_t k = 1;
+
+    constexpr static const std::size_t d = 64;
+
+    constexpr static const std::size_t r = boost::static_log2<(d - k)>::value;
+    constexpr static const std::size_t m = 2;
+
+    typedef zk::commitments::fri<FieldType, merkle_hash_type, transcript_hash_type, lambda, m> fri_type;
+
+    typedef zk::commitments::
+        list_polynomial_commitment_params<merkle_hash_type, transcript_hash_type, lambda, m>
+            lpc_params_type;
+    typedef zk::commitments::list_polynomial_commitment<FieldType, lpc_params_type> lpc_type;
+    typedef zk::commitments::lpc_commitment_scheme<lpc_type> lpc_scheme_type;
+
+    lpc_step_list_fixture() :
+        D(math::calculate_domain_set<FieldType>(boost::static_log2<d>::value, r + 1)),
+        batch_0(generate_random_polynomial_dfs_batch<FieldType>(dist_type(1, 10)(test_global_rnd_engine), d, test_global_alg_rnd_engine<FieldType>)),
+        batch_1(generate_random_polynomial_dfs_batch<FieldType>(dist_type(1, 10)(test_global_rnd_engine), d, test_global_alg_rnd_engine<FieldType>)),
+        point(algebra::fields::arithmetic_params<FieldType>::multiplicative_generator) {
+    }
+
+    typename fri_type::params_type make_fri_params(const std::vector<std::size_t> &step_list) const {
+        typename fri_type::params_type fri_params;
+
+        fri_params.r = r;
+        fri_params.D = D;
+        fri_params.max_degree = d - 1;
+        fri_params.step_list = step_list;
+        return fri_params;
+    }
+
+    // Commits both batches, proves them at point and checks that the verifier accepts the proof.
+    typename lpc_type::proof_type prove_and_verify(const typename fri_type::params_type &fri_params) const {
+        lpc_scheme_type lpc_scheme_prover(fri_params);
+        lpc_scheme_type lpc_scheme_verifier(fri_params);
+
+        lpc_scheme_prover.append_to_batch(0, batch_0);
+        lpc_scheme_prover.append_to_batch(1, batch_1);
+
+        std::map<std::size_t, typename lpc_type::commitment_type> commitments;
+        commitments[0] = lpc_scheme_prover.commit(0);
+        commitments[1] = lpc_scheme_prover.commit(1);
+
+        lpc_scheme_prover.append_eval_point(0, point);
+        lpc_scheme_prover.append_eval_point(1, point);
+
+        std::array<std::uint8_t, 96> x_data {};
+
+        // Prove
+        zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript(x_data);
+        auto proof = lpc_scheme_prover.proof_eval(transcript);
+
+        // Verify
+        zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript_verifier(x_data);
+        lpc_scheme_verifier.set_batch_size(0, proof.z.get_batch_size(0));
+        lpc_scheme_verifier.set_batch_size(1, proof.z.get_batch_size(1));
+        lpc_scheme_verifier.append_eval_point(0, point);
+        lpc_scheme_verifier.append_eval_point(1, point);
+        BOOST_CHECK(lpc_scheme_verifier.verify_eval(proof, commitments, transcript_verifier));
+        return proof;
+    }
+
+    std::vector<std::shared_ptr<math::evaluation_domain<FieldType>>> D;
+    std::vector<math::polynomial_dfs<typename FieldType::value_type>> batch_0;
+    std::vector<math::polynomial_dfs<typename FieldType::value_type>> batch_1;
+    typename FieldType::value_type point;
+};
+
 BOOST_AUTO_TEST_SUITE(lpc_params_test_suite)
 BOOST_FIXTURE_TEST_CASE(lpc_batches_num_3_test, test_fixture){
     // Setup types.
@@ -639,4 +869,75 @@ BOOST_FIXTURE_TEST_CASE(lpc_different_hash_types_test, test_fixture) {
     typename FieldType::value_type prover_next_challenge = transcript.template challenge<FieldType>();
     BOOST_CHECK(verifier_next_challenge == prover_next_challenge);
 }
+
+BOOST_FIXTURE_TEST_CASE(lpc_folding_arity_test, lpc_step_list_fixture) {
+    BOOST_CHECK((zk::algorithms::make_step_list<fri_type>(r, 4) == std::vector<std::size_t>{2, 2, 1}));
+    BOOST_CHECK((zk::algorithms::make_step_list<fri_type>(r, 8) == std::vector<std::size_t>{3, 1, 1}));
+
+    for (std::size_t folding_arity : {2, 4, 8}) {
+        auto fri_params = make_fri_params(zk::algorithms::make_step_list<fri_type>(r, folding_arity));
+        BOOST_CHECK(zk::algorithms::check_step_list<fri_type>(fri_params));
+
+        auto proof = prove_and_verify(fri_params);
+        BOOST_CHECK(proof.fri_proof.fri_roots.size() == fri_params.step_list.size());
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(lpc_merkle_subtree_height_test, lpc_step_list_fixture) {
+    // Capped prover trees give the same proof as full ones, a height above the tree depth keeps the root only.
+    typename lpc_type::proof_type full_tree_proof;
+    for (std::size_t subtree_height : {0, 1, 3, 10}) {
+        auto fri_params = make_fri_params({2, 2, 1});
+        fri_params.merkle_subtree_height = subtree_height;
+
+        auto proof = prove_and_verify(fri_params);
+        if (subtree_height == 0) {
+            full_tree_proof = proof;
+        } else {
+            BOOST_CHECK(proof == full_tree_proof);
+        }
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(lpc_dfs_point_in_D0_test, lpc_step_list_fixture) {
+    // An opening point of D[0] gives the same quotient in evaluation form as in coefficient form.
+    typedef math::polynomial<typename FieldType::value_type> polynomial_type;
+    typedef zk::commitments::lpc_commitment_scheme<lpc_type, polynomial_type> lpc_coefficients_scheme_type;
+
+    auto fri_params = make_fri_params({2, 2, 1});
+    lpc_scheme_type lpc_scheme_dfs(fri_params);
+    lpc_coefficients_scheme_type lpc_scheme_coefficients(fri_params);
+
+    std::vector<polynomial_type> coefficients_0, coefficients_1;
+    for (const auto &poly : batch_0) {
+        coefficients_0.emplace_back(poly.coefficients());
+    }
+    for (const auto &poly : batch_1) {
+        coefficients_1.emplace_back(poly.coefficients());
+    }
+    lpc_scheme_dfs.append_to_batch(0, batch_0);
+    lpc_scheme_dfs.append_to_batch(1, batch_1);
+    lpc_scheme_coefficients.append_to_batch(0, coefficients_0);
+    lpc_scheme_coefficients.append_to_batch(1, coefficients_1);
+
+    BOOST_CHECK(lpc_scheme_dfs.commit(0) == lpc_scheme_coefficients.commit(0));
+    BOOST_CHECK(lpc_scheme_dfs.commit(1) == lpc_scheme_coefficients.commit(1));
+
+    auto domain_point = D[0]->get_domain_element(5);
+    lpc_scheme_dfs.append_eval_point(0, domain_point);
+    lpc_scheme_dfs.append_eval_point(1, point);
+    lpc_scheme_coefficients.append_eval_point(0, domain_point);
+    lpc_scheme_coefficients.append_eval_point(1, point);
+
+    std::array<std::uint8_t, 96> x_data {};
+    zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript_dfs(x_data);
+    zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript_coefficients(x_data);
+    auto proof_dfs = lpc_scheme_dfs.proof_eval(transcript_dfs);
+    auto proof_coefficients = lpc_scheme_coefficients.proof_eval(transcript_coefficients);
+
+    BOOST_CHECK(proof_dfs.z == proof_coefficients.z);
+    BOOST_CHECK(proof_dfs.fri_proof.fri_roots == proof_coefficients.fri_proof.fri_roots);
+    BOOST_CHECK(proof_dfs.fri_proof.final_polynomial == proof_coefficients.fri_proof.final_polynomial);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
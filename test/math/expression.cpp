@@ -39,6 +39,7 @@
 #include <nil/crypto3/zk/math/expression.hpp>
 #include <nil/crypto3/zk/math/expression_visitors.hpp>
 #include <nil/crypto3/zk/math/expression_evaluator.hpp>
+#include <nil/crypto3/zk/math/expression_compiler.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/variable.hpp>
 
 using namespace nil::crypto3;
@@ -152,4 +153,45 @@ BOOST_AUTO_TEST_CASE(expression_for_each_variable_visitor_test) {
         expected_rotations.begin(), expected_rotations.end());
 }
 
+BOOST_AUTO_TEST_CASE(expression_compiler_test) {
+
+    // setup
+    using curve_type = algebra::curves::pallas;
+    using FieldType = typename curve_type::base_field_type;
+    using variable_type = typename nil::crypto3::zk::snark::plonk_variable<typename FieldType::value_type>;
+
+    variable_type w0(0, 0, variable_type::column_type::witness);
+    variable_type w1(3, -1, variable_type::column_type::public_input);
+    variable_type w2(4, 1, variable_type::column_type::public_input);
+    variable_type w3(6, 2, variable_type::column_type::constant);
+
+    expression<variable_type> shared = (w0 + w1) * (w2 + w3);
+    expression<variable_type> expr = shared + shared - (w1 + w0).pow(3) * w2 * w3 + 5;
+
+    auto get_var_value = [&w0, &w1, &w2, &w3](const variable_type& var) {
+        if (var == w0) return variable_type::assignment_type(1);
+        if (var == w1) return variable_type::assignment_type(2);
+        if (var == w2) return variable_type::assignment_type(3);
+        if (var == w3) return variable_type::assignment_type(4);
+        return variable_type::assignment_type::zero();
+    };
+
+    compiled_expression<variable_type> program = expression_compiler<variable_type>::compile(expr);
+    compiled_expression_evaluator<variable_type> compiled_evaluator(program, get_var_value);
+    expression_evaluator<variable_type> evaluator(expr, get_var_value);
+
+    BOOST_CHECK(compiled_evaluator.evaluate() == evaluator.evaluate());
+    BOOST_CHECK_EQUAL(program.variables().size(), 4);
+
+    // w0 + w1 is computed once, 'shared' is computed once.
+    std::size_t additions = 0;
+    for (const auto& instruction : program.instructions()) {
+        if (instruction.op == expression_opcode::ADD) {
+            additions++;
+        }
+    }
+    BOOST_CHECK_EQUAL(additions, 4);
+    BOOST_CHECK(program.registers_number() < program.instructions().size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -124,6 +124,15 @@ void test_qap(const std::size_t qap_degree, const std::size_t num_inputs, const
 
     BOOST_CHECK(qap_inst_1.is_satisfied(qap_wit));
     BOOST_CHECK(qap_inst_2.is_satisfied(qap_wit));
+
+    // A workspace reused across the calls gives the same witness.
+    reductions::r1cs_to_qap_workspace<FieldType> workspace;
+    for (std::size_t i = 0; i < 2; i++) {
+        qap_witness<FieldType> qap_wit_workspace = reductions::r1cs_to_qap<FieldType>::witness_map(
+            example.constraint_system, example.primary_input, example.auxiliary_input, d1, d2, d3, workspace);
+        BOOST_CHECK(qap_wit_workspace.coefficients_for_H == qap_wit.coefficients_for_H);
+        BOOST_CHECK(qap_inst_1.is_satisfied(qap_wit_workspace));
+    }
 }
 
 BOOST_AUTO_TEST_SUITE(qap_test_suite)
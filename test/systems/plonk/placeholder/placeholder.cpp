@@ -72,6 +72,7 @@
 #include <nil/crypto3/zk/commitments/polynomial/lpc.hpp>
 #include <nil/crypto3/zk/commitments/polynomial/kzg.hpp>
 #include <nil/crypto3/zk/commitments/batched_commitment.hpp>
+#include <nil/crypto3/zk/detail/thread_pool.hpp>
 
 #include "circuits.hpp"
 
@@ -299,6 +300,51 @@ BOOST_FIXTURE_TEST_CASE(prover_test, test_initializer) {
     );
     BOOST_CHECK(verifier_res);
 }
+
+BOOST_FIXTURE_TEST_CASE(prover_multithreaded_test, test_initializer) {
+    auto circuit = circuit_test_1<field_type>(test_global_alg_rnd_engine<field_type>);
+
+    plonk_table_description<field_type, typename circuit_params::arithmetization_params> desc;
+
+    desc.rows_amount = circuit.table_rows;
+    desc.usable_rows_amount = circuit.usable_rows;
+    std::size_t table_rows_log = std::log2(desc.rows_amount);
+
+    typename policy_type::constraint_system_type constraint_system(circuit.gates, circuit.copy_constraints, circuit.lookup_gates);
+    typename policy_type::variable_assignment_type assignments = circuit.table;
+
+    std::vector<std::size_t> columns_with_copy_constraints = {0, 1, 2, 3};
+
+    typename lpc_type::fri_type::params_type fri_params = create_fri_params<typename lpc_type::fri_type, field_type>(table_rows_log);
+    lpc_scheme_type lpc_scheme(fri_params);
+
+    typename placeholder_public_preprocessor<field_type, lpc_placeholder_params_type>::preprocessed_data_type
+        lpc_preprocessed_public_data = placeholder_public_preprocessor<field_type, lpc_placeholder_params_type>::process(
+            constraint_system, assignments.public_table(), desc, lpc_scheme, columns_with_copy_constraints.size()
+        );
+
+    typename placeholder_private_preprocessor<field_type, lpc_placeholder_params_type>::preprocessed_data_type
+        lpc_preprocessed_private_data = placeholder_private_preprocessor<field_type, lpc_placeholder_params_type>::process(
+            constraint_system, assignments.private_table(), desc
+        );
+
+    auto lpc_proof = placeholder_prover<field_type, lpc_placeholder_params_type>::process(
+        lpc_preprocessed_public_data, lpc_preprocessed_private_data, desc, constraint_system, assignments, lpc_scheme
+    );
+
+    // The proof must not depend on the number of prover threads.
+    zk::detail::thread_pool::instance().resize(4);
+    auto lpc_proof_multithreaded = placeholder_prover<field_type, lpc_placeholder_params_type>::process(
+        lpc_preprocessed_public_data, lpc_preprocessed_private_data, desc, constraint_system, assignments, lpc_scheme
+    );
+    zk::detail::thread_pool::instance().resize(1);
+    BOOST_CHECK(lpc_proof == lpc_proof_multithreaded);
+
+    bool verifier_res = placeholder_verifier<field_type, lpc_placeholder_params_type>::process(
+        lpc_preprocessed_public_data, lpc_proof_multithreaded, constraint_system, lpc_scheme
+    );
+    BOOST_CHECK(verifier_res);
+}
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(placeholder_circuit2)
@@ -829,6 +875,44 @@ BOOST_AUTO_TEST_CASE(lookup_test) {
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE(lookup_constraint_tag_test) {
+    using value_type = typename field_type::value_type;
+    using lookup_argument_type = placeholder_lookup_argument<field_type, lpc_scheme_type, lpc_placeholder_params_type>;
+
+    std::vector<value_type> tag_values(table_rows);
+    for (value_type &value : tag_values) {
+        value = algebra::random_element<field_type>();
+    }
+    math::polynomial_dfs<value_type> tag_column(table_rows - 1, tag_values);
+    value_type x = algebra::random_element<field_type>();
+
+    // Against the product of (tag - i) / (constraint_id - i), multiplied out one factor at a time.
+    for (auto [constraints_num, constraint_id] : std::vector<std::pair<std::size_t, std::size_t>>(
+             {{1, 1}, {2, 1}, {2, 2}, {3, 2}, {5, 1}, {5, 4}})) {
+        std::size_t table_id = constraint_id + 2;
+
+        math::polynomial_dfs<value_type> expected_column = tag_column;
+        value_type expected_value = tag_values[1];
+        for (std::size_t i = 1; i <= constraints_num; i++) {
+            if (i != constraint_id) {
+                math::polynomial_dfs<value_type> factor = tag_column - value_type(i);
+                factor /= value_type(constraint_id) - value_type(i);
+                expected_column *= factor;
+                expected_value *= (tag_values[1] - value_type(i)) / (value_type(constraint_id) - value_type(i));
+            }
+        }
+        expected_column /= value_type(constraint_id);
+        expected_column *= value_type(table_id);
+        expected_value *= value_type(table_id) / value_type(constraint_id);
+
+        math::polynomial_dfs<value_type> column = lookup_argument_type::get_constraint_tag_from_gate_tag_column(
+            tag_column, constraints_num, constraint_id, table_id);
+        BOOST_CHECK(column.evaluate(x) == expected_column.evaluate(x));
+        BOOST_CHECK(lookup_argument_type::get_constraint_tag_value_from_gate_tag_value(
+                        tag_values[1], constraints_num, constraint_id, table_id) == expected_value);
+    }
+}
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(placeholder_circuit4)
@@ -0,0 +1,109 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE fixed_base_multiexp_performance_test
+
+// Do it manually for all performance tests
+#define ZK_PLACEHOLDER_PROFILING_ENABLED
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/algebra/curves/mnt4.hpp>
+#include <nil/crypto3/algebra/fields/mnt4/base_field.hpp>
+#include <nil/crypto3/algebra/fields/mnt4/scalar_field.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/mnt4.hpp>
+#include <nil/crypto3/algebra/curves/params/multiexp/mnt4.hpp>
+#include <nil/crypto3/algebra/curves/params/wnaf/mnt4.hpp>
+#include <nil/crypto3/algebra/multiexp/multiexp.hpp>
+#include <nil/crypto3/algebra/multiexp/policies.hpp>
+#include <nil/crypto3/algebra/random_element.hpp>
+
+#include <nil/crypto3/zk/snark/systems/ppzksnark/r1cs_gg_ppzksnark/detail/fixed_base_multiexp.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_scoped_profiler.hpp>
+
+using namespace nil::crypto3;
+using namespace nil::crypto3::algebra;
+
+BOOST_AUTO_TEST_SUITE(fixed_base_multiexp_performance_test_suite)
+
+// A prover multiexp part over fixed bases: BDLO12 against the default table and the former 8-bit, stride 4 one.
+BOOST_AUTO_TEST_CASE(fixed_base_multiexp_part) {
+    typedef curves::mnt4<298> curve_type;
+    typedef typename curve_type::template g1_type<> g1_type;
+    typedef typename curve_type::scalar_field_type scalar_field_type;
+    typedef zk::snark::detail::fixed_base_table<g1_type, scalar_field_type> table_type;
+    typedef std::chrono::steady_clock clock_type;
+
+    const std::size_t size = zk::snark::detail::multiexp_max_part_size;
+    const std::size_t runs = 4;
+
+    std::vector<typename g1_type::value_type> bases;
+    std::vector<typename scalar_field_type::value_type> scalars;
+    for (std::size_t i = 0; i < size; i++) {
+        bases.push_back(random_element<g1_type>());
+        scalars.push_back(random_element<scalar_field_type>());
+    }
+
+    table_type table(bases.begin(), bases.end(), table_type::optimal_window_bits(size), 1);
+    table_type former_table(bases.begin(), bases.end(), 8, 4);
+    std::cout << "Window bits " << table.window_bits() << ", points per base " << table.points_per_base()
+              << std::endl;
+
+    typename g1_type::value_type expected;
+    std::chrono::duration<double> multiexp_time(0), table_time(0), former_table_time(0);
+    for (std::size_t run = 0; run < runs; run++) {
+        auto start = clock_type::now();
+        {
+            PROFILE_PLACEHOLDER_SCOPE("BDLO12 multiexp");
+            expected = multiexp<policies::multiexp_method_BDLO12>(bases.begin(), bases.end(), scalars.begin(),
+                                                                 scalars.end(), 1);
+        }
+        multiexp_time += clock_type::now() - start;
+
+        start = clock_type::now();
+        {
+            PROFILE_PLACEHOLDER_SCOPE("Fixed-base table multiexp");
+            BOOST_CHECK(table.multiexp(0, scalars.begin(), scalars.end()) == expected);
+        }
+        table_time += clock_type::now() - start;
+
+        start = clock_type::now();
+        {
+            PROFILE_PLACEHOLDER_SCOPE("Former fixed-base table multiexp");
+            BOOST_CHECK(former_table.multiexp(0, scalars.begin(), scalars.end()) == expected);
+        }
+        former_table_time += clock_type::now() - start;
+    }
+
+    std::cout << "BDLO12: " << multiexp_time.count() / runs << " s, table: " << table_time.count() / runs
+              << " s, speedup " << multiexp_time.count() / table_time.count() << std::endl;
+    std::cout << "Former table: " << former_table_time.count() / runs << " s, speedup "
+              << multiexp_time.count() / former_table_time.count() << std::endl;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -32,6 +32,8 @@
 
 #include <cassert>
 #include <cstdio>
+#include <random>
+#include <vector>
 
 #include <nil/crypto3/algebra/curves/mnt4.hpp>
 #include <nil/crypto3/algebra/fields/mnt4/base_field.hpp>
@@ -43,6 +45,12 @@
 #include <nil/crypto3/algebra/pairing/mnt4.hpp>
 #include <nil/crypto3/algebra/pairing/mnt6.hpp>
 #include <nil/crypto3/algebra/algorithms/pair.hpp>
+#include <nil/crypto3/algebra/multiexp/multiexp.hpp>
+#include <nil/crypto3/algebra/multiexp/policies.hpp>
+#include <nil/crypto3/algebra/random_element.hpp>
+
+#include <nil/crypto3/zk/detail/thread_pool.hpp>
+#include <nil/crypto3/zk/snark/systems/ppzksnark/r1cs_gg_ppzksnark/detail/small_scalar_multiexp.hpp>
 
 #include "../r1cs_examples.hpp"
 #include "run_r1cs_gg_ppzksnark.hpp"
@@ -58,10 +66,190 @@ void run_r1cs_gg_ppzksnark_basic_test(std::size_t num_constraints, std::size_t i
     BOOST_CHECK(bit);
 }
 
+/**
+ * Constraint system satisfied by the powers of any seed: auxiliary input i is seed^(i + 1) and primary input j is
+ * seed^(j + 1), so different seeds give different witnesses for the same constraint system.
+ */
+template<typename FieldType>
+r1cs_example<FieldType> generate_r1cs_powers_example(std::size_t num_constraints, std::size_t num_inputs,
+                                                     const typename FieldType::value_type &seed) {
+    const std::size_t num_auxiliary = num_constraints - num_inputs + 1;
+    BOOST_CHECK(num_inputs <= num_auxiliary);
+
+    r1cs_constraint_system<FieldType> cs;
+    cs.primary_input_size = num_inputs;
+    cs.auxiliary_input_size = num_auxiliary;
+
+    // w_(i + 1) = w_i * w_1
+    for (std::size_t i = 1; i < num_auxiliary; i++) {
+        math::linear_combination<math::linear_variable<FieldType>> A, B, C;
+        A.add_term(num_inputs + i, 1);
+        B.add_term(num_inputs + 1, 1);
+        C.add_term(num_inputs + i + 1, 1);
+        cs.add_constraint(r1cs_constraint<FieldType>(A, B, C));
+    }
+    // x_j = w_j * 1
+    for (std::size_t j = 1; j <= num_inputs; j++) {
+        math::linear_combination<math::linear_variable<FieldType>> A, B, C;
+        A.add_term(num_inputs + j, 1);
+        B.add_term(0, 1);
+        C.add_term(j, 1);
+        cs.add_constraint(r1cs_constraint<FieldType>(A, B, C));
+    }
+
+    r1cs_auxiliary_input<FieldType> auxiliary_input;
+    typename FieldType::value_type power = seed;
+    for (std::size_t i = 0; i < num_auxiliary; i++) {
+        auxiliary_input.push_back(power);
+        power *= seed;
+    }
+    r1cs_primary_input<FieldType> primary_input(auxiliary_input.begin(), auxiliary_input.begin() + num_inputs);
+
+    BOOST_CHECK(cs.num_constraints() == num_constraints);
+    BOOST_CHECK(cs.is_satisfied(primary_input, auxiliary_input));
+    return r1cs_example<FieldType>(std::move(cs), std::move(primary_input), std::move(auxiliary_input));
+}
+
+template<typename CurveType>
+void run_r1cs_gg_ppzksnark_batch_test(std::size_t num_constraints, std::size_t input_size, std::size_t batch_size) {
+    using proof_system = r1cs_gg_ppzksnark<CurveType>;
+    using scalar_field_type = typename CurveType::scalar_field_type;
+
+    // Every entry of the batch has its own witness.
+    std::vector<r1cs_example<scalar_field_type>> examples;
+    for (std::size_t i = 0; i < batch_size; i++) {
+        examples.push_back(generate_r1cs_powers_example<scalar_field_type>(num_constraints, input_size,
+                                                                           random_element<scalar_field_type>()));
+    }
+    typename proof_system::keypair_type keypair =
+        nil::crypto3::zk::generate<proof_system>(examples[0].constraint_system);
+
+    std::vector<typename proof_system::primary_input_type> primary_inputs;
+    std::vector<typename proof_system::auxiliary_input_type> auxiliary_inputs;
+    for (const auto &example : examples) {
+        primary_inputs.push_back(example.primary_input);
+        auxiliary_inputs.push_back(example.auxiliary_input);
+    }
+    std::vector<typename proof_system::proof_type> proofs =
+        proof_system::prove_batch(keypair.first, primary_inputs, auxiliary_inputs);
+
+    BOOST_CHECK_EQUAL(proofs.size(), batch_size);
+    for (std::size_t i = 0; i < proofs.size(); i++) {
+        BOOST_CHECK(nil::crypto3::zk::verify<proof_system>(keypair.second, primary_inputs[i], proofs[i]));
+        if (batch_size > 1) {
+            BOOST_CHECK(!nil::crypto3::zk::verify<proof_system>(keypair.second,
+                                                                primary_inputs[(i + 1) % batch_size], proofs[i]));
+        }
+    }
+}
+
+template<typename CurveType>
+void run_r1cs_gg_ppzksnark_preprocessed_test(std::size_t num_constraints, std::size_t input_size,
+                                             std::size_t window_bits, std::size_t stride) {
+    using proof_system = r1cs_gg_ppzksnark<CurveType>;
+
+    r1cs_example<typename CurveType::scalar_field_type> example =
+        generate_r1cs_example_with_binary_input<typename CurveType::scalar_field_type>(num_constraints, input_size);
+    typename proof_system::keypair_type keypair =
+        nil::crypto3::zk::generate<proof_system>(example.constraint_system);
+    r1cs_gg_ppzksnark_preprocessed_proving_key<typename proof_system::proving_key_type> preprocessed_proving_key(
+        keypair.first, window_bits, stride);
+
+    typename proof_system::proof_type proof =
+        proof_system::prove(preprocessed_proving_key, example.primary_input, example.auxiliary_input);
+    BOOST_CHECK(nil::crypto3::zk::verify<proof_system>(keypair.second, example.primary_input, proof));
+}
+
+template<typename CurveType>
+void run_multiexp_by_scalar_size_test(std::size_t size) {
+    using g1_type = typename CurveType::template g1_type<>;
+    using scalar_field_type = typename CurveType::scalar_field_type;
+    using scalar_value_type = typename scalar_field_type::value_type;
+    using integral_type = typename scalar_field_type::integral_type;
+
+    std::mt19937_64 rng(size);
+    std::vector<typename g1_type::value_type> bases;
+    std::vector<scalar_value_type> scalars;
+    for (std::size_t i = 0; i < size; i++) {
+        bases.push_back(random_element<g1_type>());
+        // 0, 1, 2, a scalar of up to 64 bits, 2^64 - 1, 2^64 and a full-width scalar.
+        switch (i % 7) {
+            case 0:
+                scalars.push_back(scalar_value_type::zero());
+                break;
+            case 1:
+                scalars.push_back(scalar_value_type::one());
+                break;
+            case 2:
+                scalars.push_back(scalar_value_type(integral_type(2)));
+                break;
+            case 3:
+                scalars.push_back(scalar_value_type(integral_type(rng() >> (rng() % 64))));
+                break;
+            case 4:
+                scalars.push_back(scalar_value_type((integral_type(1) << 64) - 1));
+                break;
+            case 5:
+                scalars.push_back(scalar_value_type(integral_type(1) << 64));
+                break;
+            default:
+                scalars.push_back(random_element<scalar_field_type>());
+                break;
+        }
+    }
+
+    typename g1_type::value_type expected = multiexp<policies::multiexp_method_BDLO12>(
+        bases.begin(), bases.end(), scalars.begin(), scalars.end(), 1);
+    BOOST_CHECK(nil::crypto3::zk::snark::detail::multiexp_by_scalar_size<policies::multiexp_method_BDLO12>(
+        bases.begin(), bases.end(), scalars.begin(), scalars.end(), 1) == expected);
+
+    // Without full-width scalars only the short-window path and the ones remain.
+    for (std::size_t i = 6; i < size; i += 7) {
+        scalars[i] = scalar_value_type(integral_type(i));
+    }
+    expected = multiexp<policies::multiexp_method_BDLO12>(
+        bases.begin(), bases.end(), scalars.begin(), scalars.end(), 1);
+    BOOST_CHECK(nil::crypto3::zk::snark::detail::multiexp_by_scalar_size<policies::multiexp_method_BDLO12>(
+        bases.begin(), bases.end(), scalars.begin(), scalars.end(), 1) == expected);
+}
+
 BOOST_AUTO_TEST_SUITE(r1cs_gg_ppzksnark_test_suite)
 
 BOOST_AUTO_TEST_CASE(r1cs_gg_ppzksnark_basic_test) {
     run_r1cs_gg_ppzksnark_basic_test<curves::mnt4<298>>(100, 10);
 }
 
+BOOST_AUTO_TEST_CASE(r1cs_gg_ppzksnark_thread_pool_test) {
+    nil::crypto3::zk::detail::thread_pool::instance().resize(4);
+    run_r1cs_gg_ppzksnark_basic_test<curves::mnt4<298>>(100, 10);
+    nil::crypto3::zk::detail::thread_pool::instance().resize(1);
+}
+
+BOOST_AUTO_TEST_CASE(r1cs_gg_ppzksnark_batch_test) {
+    run_r1cs_gg_ppzksnark_batch_test<curves::mnt4<298>>(100, 10, 3);
+    nil::crypto3::zk::detail::thread_pool::instance().resize(4);
+    run_r1cs_gg_ppzksnark_batch_test<curves::mnt4<298>>(100, 10, 3);
+    nil::crypto3::zk::detail::thread_pool::instance().resize(1);
+}
+
+BOOST_AUTO_TEST_CASE(r1cs_gg_ppzksnark_preprocessed_test) {
+    typedef r1cs_gg_ppzksnark_preprocessed_proving_key<
+        typename r1cs_gg_ppzksnark<curves::mnt4<298>>::proving_key_type> preprocessed_proving_key_type;
+    typedef typename preprocessed_proving_key_type::g1_table_type g1_table_type;
+
+    // 298-bit scalars: 15-bit windows for a full part, the same additions as 13 and 14 bits with fewer points.
+    BOOST_CHECK_EQUAL(g1_table_type::optimal_window_bits(1 << 14), std::size_t(15));
+    BOOST_CHECK_EQUAL(g1_table_type::optimal_window_bits(100), std::size_t(8));
+
+    run_r1cs_gg_ppzksnark_preprocessed_test<curves::mnt4<298>>(100, 10, preprocessed_proving_key_type::auto_window_bits,
+                                                                 preprocessed_proving_key_type::default_stride);
+    run_r1cs_gg_ppzksnark_preprocessed_test<curves::mnt4<298>>(100, 10, 8, 1);
+    run_r1cs_gg_ppzksnark_preprocessed_test<curves::mnt4<298>>(100, 10, 5, 3);
+}
+
+BOOST_AUTO_TEST_CASE(r1cs_gg_ppzksnark_multiexp_by_scalar_size_test) {
+    run_multiexp_by_scalar_size_test<curves::mnt4<298>>(7);
+    run_multiexp_by_scalar_size_test<curves::mnt4<298>>(1000);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
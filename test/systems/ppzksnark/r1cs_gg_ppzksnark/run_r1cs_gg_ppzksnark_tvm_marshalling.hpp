@@ -153,6 +153,46 @@ namespace nil {
                         BOOST_CHECK(keypair.first.constraint_system.constraints[i] == other.constraint_system.constraints[i]);
                     }
 
+                    r1cs_gg_ppzksnark_preprocessed_proving_key<typename scheme_type::proving_key_type>
+                        preprocessed_proving_key(keypair.first, 4, 3);
+
+                    std::vector<std::uint8_t> preprocessed_proving_key_byteblob =
+                        nil::marshalling::verifier_input_serializer_tvm<scheme_type>::process(preprocessed_proving_key);
+
+                    r1cs_gg_ppzksnark_preprocessed_proving_key<typename scheme_type::proving_key_type>
+                        other_preprocessed_proving_key =
+                            nil::marshalling::verifier_input_deserializer_tvm<scheme_type>::preprocessed_proving_key_process(
+                                preprocessed_proving_key_byteblob.cbegin(),
+                                preprocessed_proving_key_byteblob.cend(),
+                                provingProcessingStatus);
+
+                    BOOST_CHECK(provingProcessingStatus == marshalling::status_type::success);
+                    BOOST_CHECK(preprocessed_proving_key == other_preprocessed_proving_key);
+                    BOOST_CHECK(verify<scheme_type>(
+                        keypair.second, example.primary_input,
+                        scheme_type::prove(other_preprocessed_proving_key, example.primary_input,
+                                           example.auxiliary_input)));
+
+                    // Truncated data and tables that do not match the queries of the proving key are rejected.
+                    std::vector<std::uint8_t> truncated_byteblob(preprocessed_proving_key_byteblob.begin(),
+                                                                 preprocessed_proving_key_byteblob.end() - 1);
+                    nil::marshalling::verifier_input_deserializer_tvm<scheme_type>::preprocessed_proving_key_process(
+                        truncated_byteblob.cbegin(), truncated_byteblob.cend(), provingProcessingStatus);
+                    BOOST_CHECK(provingProcessingStatus != marshalling::status_type::success);
+
+                    typedef typename r1cs_gg_ppzksnark_preprocessed_proving_key<
+                        typename scheme_type::proving_key_type>::g1_table_type g1_table_type;
+                    r1cs_gg_ppzksnark_preprocessed_proving_key<typename scheme_type::proving_key_type>
+                        mismatched_preprocessed_proving_key = preprocessed_proving_key;
+                    mismatched_preprocessed_proving_key.A_table =
+                        g1_table_type(keypair.first.A_query.begin(), keypair.first.A_query.end() - 1, 4, 3);
+                    std::vector<std::uint8_t> mismatched_byteblob =
+                        nil::marshalling::verifier_input_serializer_tvm<scheme_type>::process(
+                            mismatched_preprocessed_proving_key);
+                    nil::marshalling::verifier_input_deserializer_tvm<scheme_type>::preprocessed_proving_key_process(
+                        mismatched_byteblob.cbegin(), mismatched_byteblob.cend(), provingProcessingStatus);
+                    BOOST_CHECK(provingProcessingStatus == marshalling::status_type::invalid_msg_data);
+
                     std::vector<std::uint8_t> verification_key_byteblob = nil::marshalling::verifier_input_serializer_tvm<scheme_type>::process(
                         keypair.second);
                     std::vector<std::uint8_t> primary_input_byteblob = nil::marshalling::verifier_input_serializer_tvm<scheme_type>::process(